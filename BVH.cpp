@@ -0,0 +1,433 @@
+#include "BVH.h"
+#include <algorithm>
+#include <assert.h>
+#include <cfloat>
+
+namespace
+{
+	// 軸番号(0:x 1:y 2:z)の成分
+	float GetAxis(const Vector3& v, int axis)
+	{
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+
+	// 何も含まないAABB（Growで最初の要素がそのまま入る）
+	AABB MakeEmptyAABB()
+	{
+		return AABB{ { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+	}
+
+	void Grow(AABB& aabb, const AABB& other)
+	{
+		aabb.min = { std::min(aabb.min.x, other.min.x), std::min(aabb.min.y, other.min.y), std::min(aabb.min.z, other.min.z) };
+		aabb.max = { std::max(aabb.max.x, other.max.x), std::max(aabb.max.y, other.max.y), std::max(aabb.max.z, other.max.z) };
+	}
+
+	Vector3 GetCenter(const AABB& aabb)
+	{
+		return { (aabb.min.x + aabb.max.x) * 0.5f, (aabb.min.y + aabb.max.y) * 0.5f, (aabb.min.z + aabb.max.z) * 0.5f };
+	}
+}
+
+void BVH::Build(const AABB* aabbs, uint32_t count)
+{
+	aabbs_.assign(aabbs, aabbs + count);
+	indices_.resize(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		indices_[i] = i;
+	}
+	nodes_.clear();
+	if (count == 0)
+	{
+		return;
+	}
+
+	std::vector<Vector3> centers(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		centers[i] = GetCenter(aabbs_[i]);
+	}
+
+	nodes_.reserve(size_t(count) * 2);
+	Node root{};
+	root.first = 0;
+	root.count = count;
+	UpdateLeafBounds(root);
+	nodes_.push_back(root);
+
+	// 深い木でもスタックが溢れないよう、再帰ではなく明示的なスタックで分割する
+	std::vector<uint32_t> stack;
+	stack.push_back(0);
+	while (!stack.empty())
+	{
+		uint32_t nodeIndex = stack.back();
+		stack.pop_back();
+		if (Subdivide(nodeIndex, centers))
+		{
+			stack.push_back(nodes_[nodeIndex].first);
+			stack.push_back(nodes_[nodeIndex].first + 1);
+		}
+	}
+}
+
+void BVH::SetAABB(uint32_t index, const AABB& aabb)
+{
+	assert(index < aabbs_.size());
+	aabbs_[index] = aabb;
+}
+
+void BVH::Refit()
+{
+	// 子は親より後ろにあるので、後ろから更新すれば子が先に確定する
+	for (size_t i = nodes_.size(); i-- > 0;)
+	{
+		RefitNode(uint32_t(i));
+	}
+}
+
+void BVH::Refit(JobSystem& jobSystem)
+{
+	// 根から1段ずつ開き、スレッド数より十分多い部分木に分ける。開いたノードは後で子の側から順に更新する
+	const uint32_t minSubtreeCount = jobSystem.GetThreadCount() * 8;
+	std::vector<uint32_t> upperNodes;
+	std::vector<uint32_t> subtrees;
+	std::vector<uint32_t> next;
+	if (!nodes_.empty())
+	{
+		subtrees.push_back(0);
+	}
+	bool isExpanded = true;
+	while (isExpanded && subtrees.size() < minSubtreeCount)
+	{
+		isExpanded = false;
+		next.clear();
+		for (uint32_t nodeIndex : subtrees)
+		{
+			if (nodes_[nodeIndex].count > 0)
+			{
+				next.push_back(nodeIndex);
+				continue;
+			}
+			upperNodes.push_back(nodeIndex);
+			next.push_back(nodes_[nodeIndex].first);
+			next.push_back(nodes_[nodeIndex].first + 1);
+			isExpanded = true;
+		}
+		subtrees.swap(next);
+	}
+
+	jobSystem.ParallelFor(uint32_t(subtrees.size()), 1, [&](uint32_t begin, uint32_t end)
+		{
+			// 先行順に集めたノードを逆順に更新すると、子が親より先に確定する
+			std::vector<uint32_t> order;
+			std::vector<uint32_t> stack;
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				order.clear();
+				stack.push_back(subtrees[i]);
+				while (!stack.empty())
+				{
+					uint32_t nodeIndex = stack.back();
+					stack.pop_back();
+					order.push_back(nodeIndex);
+					if (nodes_[nodeIndex].count == 0)
+					{
+						stack.push_back(nodes_[nodeIndex].first);
+						stack.push_back(nodes_[nodeIndex].first + 1);
+					}
+				}
+				for (size_t j = order.size(); j-- > 0;)
+				{
+					RefitNode(order[j]);
+				}
+			}
+		});
+
+	// 開いたノードは浅い段から並んでいるので、逆順なら子が先に確定している
+	for (size_t i = upperNodes.size(); i-- > 0;)
+	{
+		RefitNode(upperNodes[i]);
+	}
+}
+
+void BVH::QueryOverlapPairs(std::vector<CollisionPair>& pairs) const
+{
+	pairs.clear();
+	if (nodes_.empty())
+	{
+		return;
+	}
+	QueryOverlapPairs(OverlapTask{ 0, 0 }, [&](uint32_t a, uint32_t b) { pairs.push_back(CollisionPair{ a, b }); });
+}
+
+void BVH::SplitOverlapPairs(uint32_t minTaskCount, std::vector<OverlapTask>& tasks) const
+{
+	tasks.clear();
+	if (nodes_.empty())
+	{
+		return;
+	}
+
+	// QueryOverlapPairsと同じ規則で1段ずつ開く。重ならない組は捨て、葉同士の組はそれ以上開かない
+	tasks.push_back(OverlapTask{ 0, 0 });
+	std::vector<OverlapTask> next;
+	bool isExpanded = true;
+	while (isExpanded && tasks.size() < minTaskCount)
+	{
+		isExpanded = false;
+		next.clear();
+		for (const OverlapTask& task : tasks)
+		{
+			const Node& nodeA = nodes_[task.nodeA];
+			const Node& nodeB = nodes_[task.nodeB];
+			if (task.nodeA == task.nodeB)
+			{
+				if (nodeA.count > 0)
+				{
+					next.push_back(task);
+					continue;
+				}
+				next.push_back(OverlapTask{ nodeA.first, nodeA.first });
+				next.push_back(OverlapTask{ nodeA.first + 1, nodeA.first + 1 });
+				next.push_back(OverlapTask{ nodeA.first, nodeA.first + 1 });
+				isExpanded = true;
+				continue;
+			}
+			if (!mathFunc_.IsCollision(nodeA.bounds, nodeB.bounds))
+			{
+				continue;
+			}
+			if (nodeA.count > 0 && nodeB.count > 0)
+			{
+				next.push_back(task);
+			}
+			else if (nodeA.count > 0 || (nodeB.count == 0 && HalfArea(nodeB.bounds) > HalfArea(nodeA.bounds)))
+			{
+				next.push_back(OverlapTask{ task.nodeA, nodeB.first });
+				next.push_back(OverlapTask{ task.nodeA, nodeB.first + 1 });
+				isExpanded = true;
+			}
+			else
+			{
+				next.push_back(OverlapTask{ nodeA.first, task.nodeB });
+				next.push_back(OverlapTask{ nodeA.first + 1, task.nodeB });
+				isExpanded = true;
+			}
+		}
+		tasks.swap(next);
+	}
+}
+
+template<class Overlap>
+void BVH::Query(Overlap overlap, std::vector<uint32_t>& result) const
+{
+	result.clear();
+	if (nodes_.empty())
+	{
+		return;
+	}
+
+	std::vector<uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while (!stack.empty())
+	{
+		const Node& node = nodes_[stack.back()];
+		stack.pop_back();
+		if (!overlap(node.bounds))
+		{
+			continue;
+		}
+		if (node.count > 0)
+		{
+			for (uint32_t i = 0; i < node.count; ++i)
+			{
+				uint32_t index = indices_[node.first + i];
+				if (overlap(aabbs_[index]))
+				{
+					result.push_back(index);
+				}
+			}
+		}
+		else
+		{
+			stack.push_back(node.first);
+			stack.push_back(node.first + 1);
+		}
+	}
+}
+
+void BVH::QueryAABB(const AABB& aabb, std::vector<uint32_t>& result) const
+{
+	Query([&](const AABB& bounds) { return mathFunc_.IsCollision(bounds, aabb); }, result);
+}
+
+void BVH::QuerySphere(const Sphere& sphere, std::vector<uint32_t>& result) const
+{
+	Query([&](const AABB& bounds) { return mathFunc_.IsCollision(bounds, sphere); }, result);
+}
+
+void BVH::QuerySegment(const Segment& segment, std::vector<uint32_t>& result) const
+{
+	// 逆数の計算はノードごとではなく1回だけ
+	const RayQuery query = mathFunc_.MakeRayQuery(segment);
+	Query([&](const AABB& bounds) { return mathFunc_.IsCollision(bounds, query); }, result);
+}
+
+bool BVH::Subdivide(uint32_t nodeIndex, const std::vector<Vector3>& centers)
+{
+	// push_backで参照が無効になるので値で持つ
+	const uint32_t first = nodes_[nodeIndex].first;
+	const uint32_t count = nodes_[nodeIndex].count;
+	if (count <= 1)
+	{
+		return false;
+	}
+
+	// 中心の範囲でビンを切る
+	AABB centerBounds = MakeEmptyAABB();
+	for (uint32_t i = first; i < first + count; ++i)
+	{
+		const Vector3& center = centers[indices_[i]];
+		Grow(centerBounds, AABB{ center, center });
+	}
+
+	float bestCost = FLT_MAX;
+	int bestAxis = -1;
+	uint32_t bestSplit = 0;		//このビンまでを左にする
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		const float minCenter = GetAxis(centerBounds.min, axis);
+		const float extent = GetAxis(centerBounds.max, axis) - minCenter;
+		if (extent <= 0.0f)
+		{
+			continue;
+		}
+		const float scale = kBinCount / extent;
+
+		AABB binBounds[kBinCount];
+		uint32_t binCounts[kBinCount] = {};
+		for (uint32_t b = 0; b < kBinCount; ++b)
+		{
+			binBounds[b] = MakeEmptyAABB();
+		}
+		for (uint32_t i = first; i < first + count; ++i)
+		{
+			uint32_t index = indices_[i];
+			uint32_t b = std::min(kBinCount - 1, uint32_t((GetAxis(centers[index], axis) - minCenter) * scale));
+			binCounts[b]++;
+			Grow(binBounds[b], aabbs_[index]);
+		}
+
+		// 右側の累積を先に作り、左から掃引してコストを求める
+		float rightAreas[kBinCount];
+		uint32_t rightCounts[kBinCount];
+		AABB rightBounds = MakeEmptyAABB();
+		uint32_t rightCount = 0;
+		for (uint32_t b = kBinCount - 1; b > 0; --b)
+		{
+			Grow(rightBounds, binBounds[b]);
+			rightCount += binCounts[b];
+			rightAreas[b] = HalfArea(rightBounds);
+			rightCounts[b] = rightCount;
+		}
+		AABB leftBounds = MakeEmptyAABB();
+		uint32_t leftCount = 0;
+		for (uint32_t b = 0; b + 1 < kBinCount; ++b)
+		{
+			Grow(leftBounds, binBounds[b]);
+			leftCount += binCounts[b];
+			if (leftCount == 0 || rightCounts[b + 1] == 0)
+			{
+				continue;
+			}
+			float cost = leftCount * HalfArea(leftBounds) + rightCounts[b + 1] * rightAreas[b + 1];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = b;
+			}
+		}
+	}
+
+	uint32_t middle = 0;
+	if (bestAxis < 0)
+	{
+		// 中心が全て同じ位置。大きい葉を避けるため半分に分ける
+		if (count <= kMaxLeafSize)
+		{
+			return false;
+		}
+		middle = first + count / 2;
+	}
+	else
+	{
+		const float leafCost = count * HalfArea(nodes_[nodeIndex].bounds);
+		if (bestCost >= leafCost && count <= kMaxLeafSize)
+		{
+			return false;
+		}
+		const float minCenter = GetAxis(centerBounds.min, bestAxis);
+		const float scale = kBinCount / (GetAxis(centerBounds.max, bestAxis) - minCenter);
+		uint32_t* begin = indices_.data() + first;
+		uint32_t* split = std::partition(begin, begin + count, [&](uint32_t index)
+			{
+				uint32_t b = std::min(kBinCount - 1, uint32_t((GetAxis(centers[index], bestAxis) - minCenter) * scale));
+				return b <= bestSplit;
+			});
+		middle = first + uint32_t(split - begin);
+	}
+
+	const uint32_t leftIndex = uint32_t(nodes_.size());
+	Node left{};
+	left.first = first;
+	left.count = middle - first;
+	UpdateLeafBounds(left);
+	Node right{};
+	right.first = middle;
+	right.count = first + count - middle;
+	UpdateLeafBounds(right);
+	nodes_.push_back(left);
+	nodes_.push_back(right);
+	nodes_[nodeIndex].first = leftIndex;
+	nodes_[nodeIndex].count = 0;
+
+	return true;
+}
+
+void BVH::UpdateLeafBounds(Node& node) const
+{
+	node.bounds = MakeEmptyAABB();
+	for (uint32_t i = node.first; i < node.first + node.count; ++i)
+	{
+		Grow(node.bounds, aabbs_[indices_[i]]);
+	}
+}
+
+void BVH::RefitNode(uint32_t nodeIndex)
+{
+	Node& node = nodes_[nodeIndex];
+	if (node.count > 0)
+	{
+		UpdateLeafBounds(node);
+	}
+	else
+	{
+		node.bounds = nodes_[node.first].bounds;
+		Grow(node.bounds, nodes_[node.first + 1].bounds);
+	}
+}
+
+float BVH::HalfArea(const AABB& aabb)
+{
+	if (aabb.min.x > aabb.max.x)
+	{
+		return 0.0f;
+	}
+	float x = aabb.max.x - aabb.min.x;
+	float y = aabb.max.y - aabb.min.y;
+	float z = aabb.max.z - aabb.min.z;
+	return x * y + y * z + z * x;
+}
@@ -0,0 +1,302 @@
+#pragma once
+#include "AABB.h"
+#include "CollisionPair.h"
+#include "JobSystem.h"
+#include "RayQuery.h"
+#include "MathFunction.h"
+#include "Segment.h"
+#include "Sphereh.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// AABBの階層構造（Bounding Volume Hierarchy）。ビン分割のSAHで構築し、
+/// 物体が動いたときは木の形を変えずに境界だけ更新（リフィット）する
+/// </summary>
+class BVH
+{
+public:
+	/// <summary>
+	/// 木を構築する（物体の番号は配列の添え字）
+	/// </summary>
+	/// <param name="aabbs"></param>
+	/// <param name="count"></param>
+	void Build(const AABB* aabbs, uint32_t count);
+
+	/// <summary>
+	/// 物体のAABBを差し替える。Refitを呼ぶまで木には反映されない
+	/// </summary>
+	/// <param name="index"></param>
+	/// <param name="aabb"></param>
+	void SetAABB(uint32_t index, const AABB& aabb);
+	/// <summary>
+	/// 木の形はそのままで、全ノードの境界を葉から更新する
+	/// </summary>
+	void Refit();
+	/// <summary>
+	/// Refitを部分木ごとに並列で行う
+	/// </summary>
+	/// <param name="jobSystem"></param>
+	void Refit(JobSystem& jobSystem);
+
+	/// <summary>
+	/// 重なっている物体の組を全て求める
+	/// </summary>
+	/// <param name="pairs">結果（上書き）</param>
+	void QueryOverlapPairs(std::vector<CollisionPair>& pairs) const;
+
+	//重なっている組を求める探索の一部（ノードの組。同じノード同士ならそのノードの中の組）
+	struct OverlapTask final
+	{
+		uint32_t nodeA;		//!<ノード
+		uint32_t nodeB;		//!<ノード
+	};
+	/// <summary>
+	/// 重なっている組を求める探索を、互いに同じ組を含まない部分に分ける（並列に処理するため）。分け方は木だけで決まる
+	/// </summary>
+	/// <param name="minTaskCount">少なくともこの数になるまで分ける（木が小さければ少なくなる）</param>
+	/// <param name="tasks">結果（上書き）</param>
+	void SplitOverlapPairs(uint32_t minTaskCount, std::vector<OverlapTask>& tasks) const;
+	/// <summary>
+	/// 探索の一部について、AABBが重なっている物体の組を列挙する
+	/// </summary>
+	/// <param name="task"></param>
+	/// <param name="pairFunction">void(小さい方の番号, 大きい方の番号)</param>
+	template<class PairFunction>
+	void QueryOverlapPairs(const OverlapTask& task, PairFunction pairFunction) const;
+	/// <summary>
+	/// AABBと重なる物体を求める
+	/// </summary>
+	/// <param name="aabb"></param>
+	/// <param name="result">物体の番号（上書き）</param>
+	void QueryAABB(const AABB& aabb, std::vector<uint32_t>& result) const;
+	/// <summary>
+	/// 球と重なる物体を求める
+	/// </summary>
+	/// <param name="sphere"></param>
+	/// <param name="result">物体の番号（上書き）</param>
+	void QuerySphere(const Sphere& sphere, std::vector<uint32_t>& result) const;
+	/// <summary>
+	/// 線分が通る物体を求める
+	/// </summary>
+	/// <param name="segment"></param>
+	/// <param name="result">物体の番号（上書き）</param>
+	void QuerySegment(const Segment& segment, std::vector<uint32_t>& result) const;
+
+	/// <summary>
+	/// 半直線・線分が最初に当たる物体を求める。ノードは入るtが近い順に辿り、見つかった交点より遠いノードは飛ばす
+	/// </summary>
+	/// <param name="query"></param>
+	/// <param name="hitFunction">bool(物体の番号, tの上限, float* t)。上限以下で当たればtを書いてtrueを返す</param>
+	/// <param name="hitIndex">当たった物体の番号</param>
+	/// <param name="tHit">指定すると当たったときのtを受け取る</param>
+	/// <returns>当たればtrue</returns>
+	template<class HitFunction>
+	bool Raycast(const RayQuery& query, HitFunction hitFunction, uint32_t* hitIndex, float* tHit = nullptr) const;
+
+	/// <summary>
+	/// 物体の数
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetCount() const { return uint32_t(aabbs_.size()); }
+	/// <summary>
+	/// 物体のAABB
+	/// </summary>
+	/// <param name="index"></param>
+	/// <returns></returns>
+	const AABB& GetAABB(uint32_t index) const { return aabbs_[index]; }
+	/// <summary>
+	/// ノード数
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetNodeCount() const { return uint32_t(nodes_.size()); }
+
+private:
+	//ノード。葉なら indices_[first]から count個が物体、内部ノードなら first と first+1 が子
+	struct Node final
+	{
+		AABB bounds;		//!<境界
+		uint32_t first;		//!<子ノード、または物体の先頭
+		uint32_t count;		//!<物体の数（0なら内部ノード）
+	};
+
+	static const uint32_t kBinCount = 16;		//SAHのビン数
+	static const uint32_t kMaxLeafSize = 4;		//葉に入れる物体の最大数（SAHで得がなくても分割する）
+
+	/// <summary>
+	/// ノードを2つの子に分割する
+	/// </summary>
+	/// <param name="nodeIndex"></param>
+	/// <param name="centers">物体の中心</param>
+	/// <returns>分割した場合はtrue（葉のままならfalse）</returns>
+	bool Subdivide(uint32_t nodeIndex, const std::vector<Vector3>& centers);
+	/// <summary>
+	/// 葉の物体から境界を求める
+	/// </summary>
+	/// <param name="node"></param>
+	void UpdateLeafBounds(Node& node) const;
+	/// <summary>
+	/// ノードの境界を、葉なら物体から、内部ノードなら子から求め直す
+	/// </summary>
+	/// <param name="nodeIndex"></param>
+	void RefitNode(uint32_t nodeIndex);
+	/// <summary>
+	/// 表面積の半分（SAHでは比だけが必要）
+	/// </summary>
+	/// <param name="aabb"></param>
+	/// <returns></returns>
+	static float HalfArea(const AABB& aabb);
+
+	/// <summary>
+	/// 判定関数を満たす物体を求める（ノードの境界にも同じ判定を使う）
+	/// </summary>
+	template<class Overlap>
+	void Query(Overlap overlap, std::vector<uint32_t>& result) const;
+
+	std::vector<AABB> aabbs_;			//物体のAABB
+	std::vector<uint32_t> indices_;		//葉が参照する物体の番号
+	std::vector<Node> nodes_;			//ノード（親は子より前にある）
+	mutable MathFunction mathFunc_;		//ノードの境界・葉の形状との衝突判定（描画先は使わない）
+};
+
+template<class PairFunction>
+void BVH::QueryOverlapPairs(const OverlapTask& task, PairFunction pairFunction) const
+{
+	auto addPair = [&](uint32_t a, uint32_t b)
+	{
+		if (mathFunc_.IsCollision(aabbs_[a], aabbs_[b]))
+		{
+			a < b ? pairFunction(a, b) : pairFunction(b, a);
+		}
+	};
+
+	// ノードの組を辿る。同じノード同士の組はそのノード内の組を表す
+	std::vector<std::pair<uint32_t, uint32_t>> stack;
+	stack.reserve(64);
+	stack.emplace_back(task.nodeA, task.nodeB);
+	while (!stack.empty())
+	{
+		auto [a, b] = stack.back();
+		stack.pop_back();
+		const Node& nodeA = nodes_[a];
+		const Node& nodeB = nodes_[b];
+
+		if (a == b)
+		{
+			if (nodeA.count > 0)
+			{
+				for (uint32_t i = 0; i < nodeA.count; ++i)
+				{
+					for (uint32_t j = i + 1; j < nodeA.count; ++j)
+					{
+						addPair(indices_[nodeA.first + i], indices_[nodeA.first + j]);
+					}
+				}
+			}
+			else
+			{
+				stack.emplace_back(nodeA.first, nodeA.first);
+				stack.emplace_back(nodeA.first + 1, nodeA.first + 1);
+				stack.emplace_back(nodeA.first, nodeA.first + 1);
+			}
+			continue;
+		}
+
+		if (!mathFunc_.IsCollision(nodeA.bounds, nodeB.bounds))
+		{
+			continue;
+		}
+		if (nodeA.count > 0 && nodeB.count > 0)
+		{
+			for (uint32_t i = 0; i < nodeA.count; ++i)
+			{
+				for (uint32_t j = 0; j < nodeB.count; ++j)
+				{
+					addPair(indices_[nodeA.first + i], indices_[nodeB.first + j]);
+				}
+			}
+		}
+		else if (nodeA.count > 0 || (nodeB.count == 0 && HalfArea(nodeB.bounds) > HalfArea(nodeA.bounds)))
+		{
+			// 大きい方（葉でない方）を分割する
+			stack.emplace_back(a, nodeB.first);
+			stack.emplace_back(a, nodeB.first + 1);
+		}
+		else
+		{
+			stack.emplace_back(nodeA.first, b);
+			stack.emplace_back(nodeA.first + 1, b);
+		}
+	}
+}
+
+template<class HitFunction>
+bool BVH::Raycast(const RayQuery& query, HitFunction hitFunction, uint32_t* hitIndex, float* tHit) const
+{
+	float enter = 0.0f;
+	if (nodes_.empty() || !mathFunc_.IsCollision(nodes_[0].bounds, query, &enter))
+	{
+		return false;
+	}
+
+	// 当たるたびにtの上限を縮め、以降のノードの判定に使う
+	RayQuery clipped = query;
+	bool isHit = false;
+	std::vector<std::pair<uint32_t, float>> stack;
+	stack.reserve(64);
+	stack.emplace_back(0, enter);
+	while (!stack.empty())
+	{
+		auto [nodeIndex, nodeEnter] = stack.back();
+		stack.pop_back();
+		if (nodeEnter > clipped.tMax)
+		{
+			continue;
+		}
+		const Node& node = nodes_[nodeIndex];
+		if (node.count > 0)
+		{
+			for (uint32_t i = 0; i < node.count; ++i)
+			{
+				uint32_t index = indices_[node.first + i];
+				float t = 0.0f;
+				if (hitFunction(index, clipped.tMax, &t))
+				{
+					clipped.tMax = t;
+					*hitIndex = index;
+					isHit = true;
+				}
+			}
+			continue;
+		}
+
+		float enterLeft = 0.0f;
+		float enterRight = 0.0f;
+		bool isHitLeft = mathFunc_.IsCollision(nodes_[node.first].bounds, clipped, &enterLeft);
+		bool isHitRight = mathFunc_.IsCollision(nodes_[node.first + 1].bounds, clipped, &enterRight);
+		// 近い方を後に積んで先に調べる
+		if (isHitLeft && isHitRight && enterLeft > enterRight)
+		{
+			stack.emplace_back(node.first, enterLeft);
+			stack.emplace_back(node.first + 1, enterRight);
+		}
+		else
+		{
+			if (isHitRight)
+			{
+				stack.emplace_back(node.first + 1, enterRight);
+			}
+			if (isHitLeft)
+			{
+				stack.emplace_back(node.first, enterLeft);
+			}
+		}
+	}
+
+	if (isHit && tHit)
+	{
+		*tHit = clipped.tMax;
+	}
+	return isHit;
+}
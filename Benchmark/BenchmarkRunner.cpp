@@ -0,0 +1,99 @@
+#include "BenchmarkRunner.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+BenchmarkRunner::BenchmarkRunner(double minTimeSeconds, const std::string& filter)
+	: minTimeSeconds_(minTimeSeconds), filter_(filter)
+{
+}
+
+void BenchmarkRunner::Record(const std::string& name, double nsPerOp)
+{
+	BenchmarkResult result{ name, nsPerOp, nsPerOp > 0.0 ? 1e9 / nsPerOp : 0.0 };
+	std::printf("%-48s %12.2f ns/op %16.0f ops/sec\n", name.c_str(), result.nsPerOp, result.opsPerSec);
+	std::fflush(stdout);
+	results_.push_back(result);
+}
+
+bool BenchmarkRunner::WriteJson(const std::string& path, const std::vector<BenchmarkResult>& results)
+{
+	std::ofstream file(path);
+	if (!file)
+	{
+		return false;
+	}
+	file << "{\n  \"benchmarks\": [\n";
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		char line[256];
+		std::snprintf(line, sizeof(line), "    { \"name\": \"%s\", \"ns_per_op\": %.3f, \"ops_per_sec\": %.0f }%s\n",
+			results[i].name.c_str(), results[i].nsPerOp, results[i].opsPerSec, i + 1 < results.size() ? "," : "");
+		file << line;
+	}
+	file << "  ]\n}\n";
+	return bool(file);
+}
+
+bool BenchmarkRunner::ReadJson(const std::string& path, std::vector<BenchmarkResult>& results)
+{
+	std::ifstream file(path);
+	if (!file)
+	{
+		return false;
+	}
+	std::stringstream stream;
+	stream << file.rdbuf();
+	const std::string text = stream.str();
+
+	// WriteJsonの形式だけを読めればよいので、キーを順に探していく
+	results.clear();
+	size_t position = 0;
+	while ((position = text.find("\"name\"", position)) != std::string::npos)
+	{
+		size_t nameBegin = text.find('"', text.find(':', position) + 1);
+		size_t nameEnd = text.find('"', nameBegin + 1);
+		size_t nsKey = text.find("\"ns_per_op\"", nameEnd);
+		if (nameBegin == std::string::npos || nameEnd == std::string::npos || nsKey == std::string::npos)
+		{
+			return false;
+		}
+		BenchmarkResult result{};
+		result.name = text.substr(nameBegin + 1, nameEnd - nameBegin - 1);
+		result.nsPerOp = std::strtod(text.c_str() + text.find(':', nsKey) + 1, nullptr);
+		result.opsPerSec = result.nsPerOp > 0.0 ? 1e9 / result.nsPerOp : 0.0;
+		results.push_back(result);
+		position = nsKey;
+	}
+	return true;
+}
+
+int BenchmarkRunner::Compare(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current, double thresholdPercent)
+{
+	int regressionCount = 0;
+	std::printf("\n%-48s %12s %12s %9s\n", "name", "baseline", "current", "change");
+	for (const BenchmarkResult& result : current)
+	{
+		const BenchmarkResult* base = nullptr;
+		for (const BenchmarkResult& candidate : baseline)
+		{
+			if (candidate.name == result.name)
+			{
+				base = &candidate;
+				break;
+			}
+		}
+		if (!base || base->nsPerOp <= 0.0)
+		{
+			std::printf("%-48s %12s %12.2f %9s\n", result.name.c_str(), "-", result.nsPerOp, "new");
+			continue;
+		}
+		double change = (result.nsPerOp - base->nsPerOp) / base->nsPerOp * 100.0;
+		bool isRegression = change > thresholdPercent;
+		regressionCount += isRegression ? 1 : 0;
+		std::printf("%-48s %12.2f %12.2f %+8.1f%%%s\n", result.name.c_str(), base->nsPerOp, result.nsPerOp, change, isRegression ? "  REGRESSION" : "");
+	}
+	std::printf("\n%d regression(s) over %.1f%%\n", regressionCount, thresholdPercent);
+	return regressionCount;
+}
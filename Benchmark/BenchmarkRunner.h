@@ -0,0 +1,128 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// 最適化で計算結果が捨てられないようにする
+template<class T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile unsigned char sink;
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+	for (size_t i = 0; i < sizeof(T); ++i)
+	{
+		sink = bytes[i];
+	}
+#endif
+}
+
+//1ケースの計測結果
+struct BenchmarkResult final
+{
+	std::string name;	//!< ケース名
+	double nsPerOp;		//!< 1回あたりの時間(ns)
+	double opsPerSec;	//!< 1秒あたりの回数
+};
+
+/// <summary>
+/// 自己完結型のマイクロベンチマーク実行器
+/// 各ケースは最低計測時間に達するまで回数を増やして計測し、それを数回繰り返して最速値を採る
+/// </summary>
+class BenchmarkRunner
+{
+public:
+	static const size_t kInputCount = 1024;	//入力データの数（2のべき乗。ケースには i & (kInputCount-1) を渡す）
+
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="minTimeSeconds">1回の計測の最低時間</param>
+	/// <param name="filter">この文字列を名前に含むケースだけ実行する（空なら全て）</param>
+	BenchmarkRunner(double minTimeSeconds, const std::string& filter);
+
+	/// <summary>
+	/// ケースを計測（function(index)の戻り値は最適化で消されないように使われる）
+	/// </summary>
+	/// <param name="name">ケース名</param>
+	/// <param name="function">1回分の処理。引数は入力データの番号</param>
+	template<class Function>
+	void Run(const std::string& name, Function function);
+
+	/// <summary>
+	/// 計測結果
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<BenchmarkResult>& GetResults() const { return results_; }
+
+	/// <summary>
+	/// 結果をJSONで書き出す
+	/// </summary>
+	/// <param name="path"></param>
+	/// <returns>成功したか</returns>
+	static bool WriteJson(const std::string& path, const std::vector<BenchmarkResult>& results);
+	/// <summary>
+	/// WriteJsonで書き出したJSONを読み込む
+	/// </summary>
+	/// <param name="path"></param>
+	/// <param name="results">読み込んだ結果</param>
+	/// <returns>成功したか</returns>
+	static bool ReadJson(const std::string& path, std::vector<BenchmarkResult>& results);
+	/// <summary>
+	/// 基準値と比較し、しきい値を超えて遅くなったケースを表示する
+	/// </summary>
+	/// <param name="baseline">基準値</param>
+	/// <param name="current">今回の結果</param>
+	/// <param name="thresholdPercent">許容する悪化率(%)</param>
+	/// <returns>悪化したケースの数</returns>
+	static int Compare(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current, double thresholdPercent);
+
+private:
+	void Record(const std::string& name, double nsPerOp);
+
+	double minTimeSeconds_;					//1回の計測の最低時間
+	std::string filter_;					//実行するケースの絞り込み
+	std::vector<BenchmarkResult> results_;	//計測結果
+};
+
+template<class Function>
+void BenchmarkRunner::Run(const std::string& name, Function function)
+{
+	if (!filter_.empty() && name.find(filter_) == std::string::npos)
+	{
+		return;
+	}
+
+	const int kTrials = 3;	//計測の繰り返し回数
+	double bestNsPerOp = 0.0;
+	size_t iterations = 64;
+	for (int trial = 0; trial < kTrials; ++trial)
+	{
+		while (true)
+		{
+			auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				DoNotOptimize(function(i & (kInputCount - 1)));
+			}
+			auto end = std::chrono::steady_clock::now();
+			double seconds = std::chrono::duration<double>(end - start).count();
+			if (seconds >= minTimeSeconds_)
+			{
+				double nsPerOp = seconds * 1e9 / double(iterations);
+				if (trial == 0 || nsPerOp < bestNsPerOp)
+				{
+					bestNsPerOp = nsPerOp;
+				}
+				break;
+			}
+			// 最低時間に届くまで回数を増やす
+			iterations *= seconds > 0.0 && seconds * 10.0 > minTimeSeconds_ ? 2 : 8;
+		}
+	}
+	Record(name, bestNsPerOp);
+}
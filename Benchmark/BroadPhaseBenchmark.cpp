@@ -0,0 +1,212 @@
+#include "BVH.h"
+#include "MathFunction.h"
+#include "SpatialHashGrid.h"
+#include "SweepAndPrune.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// 広域判定（ブロードフェーズ）の計測。総当たりと同じ組が見つかるかも確認する
+
+namespace
+{
+	const uint32_t kObjectCounts[] = { 1000, 10000, 100000 };
+	const uint32_t kBruteForceLimit = 10000;	// 総当たりはこの数まで計測する（100000は時間がかかりすぎる）
+
+	template<class Function>
+	double MeasureMilliseconds(Function function, int repeat)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < repeat; ++r)
+		{
+			function();
+		}
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(end - start).count() / repeat;
+	}
+
+	// 1辺0.1～0.5の箱を、1つあたり平均数個と重なる密度でばらまく
+	std::vector<AABB> MakeBoxes(uint32_t count, std::mt19937& random)
+	{
+		const float worldSize = std::cbrt(float(count));
+		std::uniform_real_distribution<float> position(0.0f, worldSize);
+		std::uniform_real_distribution<float> size(0.1f, 0.5f);
+		std::vector<AABB> boxes(count);
+		for (AABB& box : boxes)
+		{
+			box.min = { position(random), position(random), position(random) };
+			box.max = { box.min.x + size(random), box.min.y + size(random), box.min.z + size(random) };
+		}
+		return boxes;
+	}
+
+	// 半径0.1～0.25の球を、箱と同じ密度でばらまく
+	std::vector<Sphere> MakeSpheres(uint32_t count, std::mt19937& random)
+	{
+		const float worldSize = std::cbrt(float(count));
+		std::uniform_real_distribution<float> position(0.0f, worldSize);
+		std::uniform_real_distribution<float> radius(0.1f, 0.25f);
+		std::vector<Sphere> spheres(count);
+		for (Sphere& sphere : spheres)
+		{
+			sphere.center = { position(random), position(random), position(random) };
+			sphere.radius = radius(random);
+		}
+		return spheres;
+	}
+
+	// 全ての組を総当たりで判定する
+	template<class Shape>
+	size_t BruteForcePairs(MathFunction& mathFunc, const std::vector<Shape>& shapes)
+	{
+		size_t pairCount = 0;
+		for (size_t i = 0; i < shapes.size(); ++i)
+		{
+			for (size_t j = i + 1; j < shapes.size(); ++j)
+			{
+				pairCount += mathFunc.IsCollision(shapes[i], shapes[j]) ? 1 : 0;
+			}
+		}
+		return pairCount;
+	}
+}
+
+int main()
+{
+	MathFunction mathFunc;
+	std::mt19937 random(12345);
+	std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+
+	std::printf("%-8s %-28s %12s %10s\n", "objects", "case", "ms", "pairs");
+	for (uint32_t count : kObjectCounts)
+	{
+		std::vector<AABB> boxes = MakeBoxes(count, random);
+		const std::vector<AABB> startBoxes = boxes;
+		const int repeat = count <= 1000 ? 50 : (count <= 10000 ? 5 : 1);
+
+		if (count <= kBruteForceLimit)
+		{
+			size_t pairCount = 0;
+			double ms = MeasureMilliseconds([&]() { pairCount = BruteForcePairs(mathFunc, boxes); }, repeat);
+			std::printf("%-8u %-28s %12.3f %10zu\n", count, "BruteForce", ms, pairCount);
+		}
+
+		BVH bvh;
+		double buildMs = MeasureMilliseconds([&]() { bvh.Build(boxes.data(), count); }, repeat);
+		std::printf("%-8u %-28s %12.3f %10s\n", count, "BVH/Build", buildMs, "");
+
+		std::vector<CollisionPair> pairs;
+		double queryMs = MeasureMilliseconds([&]() { bvh.QueryOverlapPairs(pairs); }, repeat);
+		std::printf("%-8u %-28s %12.3f %10zu\n", count, "BVH/QueryOverlapPairs", queryMs, pairs.size());
+
+		// 少しずつ動かしてリフィット
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Vector3 move{ jitter(random), jitter(random), jitter(random) };
+			AABB box = boxes[i];
+			box.min = mathFunc.Add(box.min, move);
+			box.max = mathFunc.Add(box.max, move);
+			boxes[i] = box;
+			bvh.SetAABB(i, box);
+		}
+		double refitMs = MeasureMilliseconds([&]() { bvh.Refit(); }, repeat);
+		std::printf("%-8u %-28s %12.3f %10s\n", count, "BVH/Refit", refitMs, "");
+		double refitQueryMs = MeasureMilliseconds([&]() { bvh.QueryOverlapPairs(pairs); }, repeat);
+		std::printf("%-8u %-28s %12.3f %10zu\n", count, "BVH/QueryAfterRefit", refitQueryMs, pairs.size());
+		if (count <= kBruteForceLimit)
+		{
+			std::printf("%-8u %-28s %12s %10zu\n", count, "BruteForceAfterMove", "", BruteForcePairs(mathFunc, boxes));
+		}
+
+		std::vector<uint32_t> hits;
+		size_t hitCount = 0;
+		double sphereMs = MeasureMilliseconds([&]()
+			{
+				hitCount = 0;
+				for (uint32_t i = 0; i < 1000; ++i)
+				{
+					bvh.QuerySphere(Sphere{ bvh.GetAABB(i % count).min, 1.0f }, hits);
+					hitCount += hits.size();
+				}
+			}, repeat);
+		std::printf("%-8u %-28s %12.3f %10zu\n", count, "BVH/QuerySphere x1000", sphereMs, hitCount);
+		double segmentMs = MeasureMilliseconds([&]()
+			{
+				hitCount = 0;
+				for (uint32_t i = 0; i < 1000; ++i)
+				{
+					bvh.QuerySegment(Segment{ bvh.GetAABB(i % count).min, { 3.0f, 1.0f, 2.0f } }, hits);
+					hitCount += hits.size();
+				}
+			}, repeat);
+		std::printf("%-8u %-28s %12.3f %10zu\n", count, "BVH/QuerySegment x1000", segmentMs, hitCount);
+
+		// 同じ移動をSweep and Pruneで差分更新する
+		SweepAndPrune sweepAndPrune;
+		double sapBuildMs = MeasureMilliseconds([&]() { sweepAndPrune.Build(startBoxes.data(), count); }, repeat);
+		std::printf("%-8u %-28s %12.3f %10zu\n", count, "SAP/Build", sapBuildMs, sweepAndPrune.GetPairCount());
+		std::vector<CollisionPair> added, removed;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			sweepAndPrune.SetAABB(i, boxes[i]);
+		}
+		auto start = std::chrono::steady_clock::now();
+		sweepAndPrune.Update(added, removed);
+		auto end = std::chrono::steady_clock::now();
+		std::printf("%-8u %-28s %12.3f %10zu  (+%zu -%zu, %zu swaps)\n", count, "SAP/Update", std::chrono::duration<double, std::milli>(end - start).count(),
+			sweepAndPrune.GetPairCount(), added.size(), removed.size(), sweepAndPrune.GetSwapCount());
+		std::uniform_real_distribution<float> smallJitter(-0.002f, 0.002f);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Vector3 move{ smallJitter(random), smallJitter(random), smallJitter(random) };
+			boxes[i].min = mathFunc.Add(boxes[i].min, move);
+			boxes[i].max = mathFunc.Add(boxes[i].max, move);
+			sweepAndPrune.SetAABB(i, boxes[i]);
+		}
+		start = std::chrono::steady_clock::now();
+		sweepAndPrune.Update(added, removed);
+		end = std::chrono::steady_clock::now();
+		std::printf("%-8u %-28s %12.3f %10zu  (+%zu -%zu, %zu swaps)\n", count, "SAP/Update(small motion)", std::chrono::duration<double, std::milli>(end - start).count(),
+			sweepAndPrune.GetPairCount(), added.size(), removed.size(), sweepAndPrune.GetSwapCount());
+		if (count <= kBruteForceLimit)
+		{
+			std::printf("%-8u %-28s %12s %10zu\n", count, "BruteForceAfterMove", "", BruteForcePairs(mathFunc, boxes));
+		}
+		double sapIdleMs = MeasureMilliseconds([&]() { sweepAndPrune.Update(added, removed); }, repeat);
+		std::printf("%-8u %-28s %12.3f %10zu\n", count, "SAP/Update(no motion)", sapIdleMs, sweepAndPrune.GetPairCount());
+	}
+
+	// 球は総当たりも全ての数で計測する
+	for (uint32_t count : kObjectCounts)
+	{
+		std::vector<Sphere> spheres = MakeSpheres(count, random);
+		const int repeat = count <= 1000 ? 50 : (count <= 10000 ? 5 : 1);
+
+		size_t pairCount = 0;
+		double bruteMs = MeasureMilliseconds([&]() { pairCount = BruteForcePairs(mathFunc, spheres); }, count <= 10000 ? repeat : 1);
+		std::printf("%-8u %-28s %12.3f %10zu\n", count, "Sphere/BruteForce", bruteMs, pairCount);
+
+		SpatialHashGrid grid;
+		double buildMs = MeasureMilliseconds([&]() { grid.Build(spheres.data(), count); }, repeat);
+		std::printf("%-8u %-28s %12.3f %10s\n", count, "HashGrid/Build", buildMs, "");
+		std::vector<CollisionPair> pairs;
+		double queryMs = MeasureMilliseconds([&]() { grid.QueryOverlapPairs(pairs); }, repeat);
+		std::printf("%-8u %-28s %12.3f %10zu\n", count, "HashGrid/QueryOverlapPairs", queryMs, pairs.size());
+
+		std::vector<uint32_t> hits;
+		size_t hitCount = 0;
+		double sphereMs = MeasureMilliseconds([&]()
+			{
+				hitCount = 0;
+				for (uint32_t i = 0; i < 1000; ++i)
+				{
+					grid.QuerySphere(Sphere{ spheres[i % count].center, 1.0f }, hits);
+					hitCount += hits.size();
+				}
+			}, repeat);
+		std::printf("%-8u %-28s %12.3f %10zu\n", count, "HashGrid/QuerySphere x1000", sphereMs, hitCount);
+	}
+	return 0;
+}
@@ -0,0 +1,171 @@
+#include "CollisionWorld.h"
+#include "JobSystem.h"
+#include "MathFunction.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+// CollisionWorld::Updateのスレッド数によるスケーリングの計測
+//
+//   collision_world_benchmark            5万物体（球とAABBが半分ずつ）＋壁の平面6枚＋床の三角形
+//   collision_world_benchmark 200000     物体数を指定
+//
+// スレッド数ごとに同じ初期配置・同じ動きで数フレーム回し、1フレームの平均時間と、
+// 結果の組が1スレッドのときと完全に一致するか（決定的か）を表示する
+
+namespace
+{
+	const uint32_t kDefaultObjectCount = 50000;
+	const int kFrameCount = 10;
+	const uint32_t kThreadCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+	const uint32_t kFloorDivision = 64;		// 床は kFloorDivision × kFloorDivision マスで、1マス2枚の三角形
+
+	// 計測用の場面
+	struct Scene
+	{
+		std::vector<Sphere> spheres;
+		std::vector<AABB> aabbs;
+		std::vector<Plane> planes;
+		std::vector<Triangle> triangles;
+		float worldSize;
+	};
+
+	// BroadPhaseBenchmarkと同じ密度でばらまき、箱の壁と凸凹の床を置く
+	Scene MakeScene(uint32_t objectCount)
+	{
+		std::mt19937 random(12345);
+		Scene scene{};
+		scene.worldSize = std::cbrt(float(objectCount));
+		std::uniform_real_distribution<float> position(0.0f, scene.worldSize);
+		std::uniform_real_distribution<float> radius(0.1f, 0.25f);
+		std::uniform_real_distribution<float> size(0.1f, 0.5f);
+		std::uniform_real_distribution<float> height(0.0f, 0.5f);
+
+		scene.spheres.resize(objectCount / 2);
+		for (Sphere& sphere : scene.spheres)
+		{
+			sphere.center = { position(random), position(random), position(random) };
+			sphere.radius = radius(random);
+		}
+		scene.aabbs.resize(objectCount - objectCount / 2);
+		for (AABB& box : scene.aabbs)
+		{
+			box.min = { position(random), position(random), position(random) };
+			box.max = { box.min.x + size(random), box.min.y + size(random), box.min.z + size(random) };
+		}
+
+		const float w = scene.worldSize;
+		scene.planes = {
+			{ { 1.0f, 0.0f, 0.0f }, 0.0f }, { { 1.0f, 0.0f, 0.0f }, w },
+			{ { 0.0f, 1.0f, 0.0f }, 0.0f }, { { 0.0f, 1.0f, 0.0f }, w },
+			{ { 0.0f, 0.0f, 1.0f }, 0.0f }, { { 0.0f, 0.0f, 1.0f }, w },
+		};
+
+		std::vector<Vector3> vertices((kFloorDivision + 1) * (kFloorDivision + 1));
+		for (uint32_t z = 0; z <= kFloorDivision; ++z)
+		{
+			for (uint32_t x = 0; x <= kFloorDivision; ++x)
+			{
+				vertices[z * (kFloorDivision + 1) + x] = { w * x / kFloorDivision, height(random), w * z / kFloorDivision };
+			}
+		}
+		for (uint32_t z = 0; z < kFloorDivision; ++z)
+		{
+			for (uint32_t x = 0; x < kFloorDivision; ++x)
+			{
+				const Vector3& v00 = vertices[z * (kFloorDivision + 1) + x];
+				const Vector3& v10 = vertices[z * (kFloorDivision + 1) + x + 1];
+				const Vector3& v01 = vertices[(z + 1) * (kFloorDivision + 1) + x];
+				const Vector3& v11 = vertices[(z + 1) * (kFloorDivision + 1) + x + 1];
+				scene.triangles.push_back({ { v00, v10, v11 } });
+				scene.triangles.push_back({ { v00, v11, v01 } });
+			}
+		}
+		return scene;
+	}
+
+	// 全ての物体を少しずつ動かす（スレッド数によらず同じ動きにするため、乱数はフレームごとに作り直す）
+	void MoveObjects(MathFunction& mathFunc, CollisionWorld& world, Scene& scene, int frame)
+	{
+		std::mt19937 random(1000 + frame);
+		std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+		for (uint32_t i = 0; i < scene.spheres.size(); ++i)
+		{
+			scene.spheres[i].center = mathFunc.Add(scene.spheres[i].center, { jitter(random), jitter(random), jitter(random) });
+			world.SetSphere(i, scene.spheres[i]);
+		}
+		for (uint32_t i = 0; i < scene.aabbs.size(); ++i)
+		{
+			Vector3 move{ jitter(random), jitter(random), jitter(random) };
+			scene.aabbs[i].min = mathFunc.Add(scene.aabbs[i].min, move);
+			scene.aabbs[i].max = mathFunc.Add(scene.aabbs[i].max, move);
+			world.SetAABB(i, scene.aabbs[i]);
+		}
+	}
+
+	bool IsSamePairs(const std::vector<CollisionPair>& a, const std::vector<CollisionPair>& b)
+	{
+		return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const CollisionPair& x, const CollisionPair& y) { return x.first == y.first && x.second == y.second; });
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const uint32_t objectCount = argc > 1 ? uint32_t(std::strtoul(argv[1], nullptr, 10)) : kDefaultObjectCount;
+	const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+	MathFunction mathFunc;
+
+	std::printf("objects %u, planes 6, triangles %u, hardware threads %u, %d frames\n\n", objectCount, kFloorDivision * kFloorDivision * 2, hardwareThreads, kFrameCount);
+	std::printf("%-8s %12s %12s %9s %11s %10s %s\n", "threads", "build ms", "update ms", "speedup", "efficiency", "pairs", "same as 1 thread");
+
+	std::vector<CollisionPair> referencePairs;
+	double referenceMs = 0.0;
+	for (uint32_t threadCount : kThreadCounts)
+	{
+		// ハードウェアのスレッド数を超える数は、少なくとも16までは決定性の確認のために回す
+		if (threadCount > std::max(hardwareThreads, 16u))
+		{
+			break;
+		}
+
+		Scene scene = MakeScene(objectCount);
+		JobSystem jobSystem(threadCount);
+		CollisionWorld world;
+		world.SetSpheres(scene.spheres.data(), uint32_t(scene.spheres.size()));
+		world.SetAABBs(scene.aabbs.data(), uint32_t(scene.aabbs.size()));
+		world.SetPlanes(scene.planes.data(), uint32_t(scene.planes.size()));
+		world.SetTriangles(scene.triangles.data(), uint32_t(scene.triangles.size()));
+
+		auto buildStart = std::chrono::steady_clock::now();
+		world.Update(jobSystem);
+		auto buildEnd = std::chrono::steady_clock::now();
+		double buildMs = std::chrono::duration<double, std::milli>(buildEnd - buildStart).count();
+
+		double updateMs = 0.0;
+		for (int frame = 0; frame < kFrameCount; ++frame)
+		{
+			MoveObjects(mathFunc, world, scene, frame);
+			auto start = std::chrono::steady_clock::now();
+			world.Update(jobSystem);
+			auto end = std::chrono::steady_clock::now();
+			updateMs += std::chrono::duration<double, std::milli>(end - start).count();
+		}
+		updateMs /= kFrameCount;
+
+		const std::vector<CollisionPair>& pairs = world.GetPairs();
+		if (threadCount == 1)
+		{
+			referencePairs = pairs;
+			referenceMs = updateMs;
+		}
+		double speedup = referenceMs / updateMs;
+		std::printf("%-8u %12.3f %12.3f %8.2fx %10.0f%% %10zu %s%s\n", threadCount, buildMs, updateMs, speedup, speedup / threadCount * 100.0, pairs.size(),
+			IsSamePairs(pairs, referencePairs) ? "yes" : "NO", threadCount > hardwareThreads ? "  (oversubscribed)" : "");
+	}
+	return 0;
+}
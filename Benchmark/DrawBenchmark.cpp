@@ -0,0 +1,102 @@
+#include "LineCommandBuffer.h"
+#include "MathFunction.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+// GPUなしで描画処理を計測する。LineCommandBufferに記録した線の数と
+// チェックサムを出力するので、変更前後で描画結果が変わっていないかも確認できる
+
+namespace
+{
+	const int kWindowWidth = 1280;
+	const int kWindowHeight = 720;
+	const int kRepeat = 2000;	// 計測の繰り返し回数
+	const int kSceneRepeat = 20;	// 多数の形状を描く場面の繰り返し回数
+	const size_t kSceneShapeCount = 2000;	// 場面の形状の数（大半は画面外）
+
+	// 記録された線のチェックサム（FNV-1a）
+	uint32_t Checksum(const std::vector<LineCommand>& lines)
+	{
+		uint32_t hash = 2166136261u;
+		for (const LineCommand& line : lines)
+		{
+			const int32_t values[5] = { line.x1, line.y1, line.x2, line.y2, int32_t(line.color) };
+			for (int32_t value : values)
+			{
+				hash = (hash ^ uint32_t(value)) * 16777619u;
+			}
+		}
+		return hash;
+	}
+
+	template<class Function>
+	void Measure(const char* name, LineCommandBuffer& buffer, Function function, int repeat = kRepeat)
+	{
+		buffer.Clear();
+		function();
+		size_t submitted = buffer.GetSubmittedCount();
+		size_t recorded = buffer.GetLines().size();
+		uint32_t checksum = Checksum(buffer.GetLines());
+
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < repeat; ++r)
+		{
+			buffer.Clear();
+			function();
+		}
+		auto end = std::chrono::steady_clock::now();
+		double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / repeat;
+		std::printf("%-16s %10.1f ns/call  lines %5zu (recorded %5zu)  checksum %08x\n", name, ns, submitted, recorded, checksum);
+	}
+}
+
+int main()
+{
+	MathFunction mathFunc;
+	LineCommandBuffer buffer(kWindowWidth, kWindowHeight);
+	mathFunc.SetDrawSink(&buffer);
+
+	// main.cppと同じカメラ
+	Matrix4x4 projectionMatrix = mathFunc.MakePerspectiveFovMatrix(0.45f, float(kWindowWidth) / float(kWindowHeight), 0.1f, 100.0f);
+	Matrix4x4 viewportMatrix = mathFunc.MakeViewportMatrix(0.0f, 0.0f, float(kWindowWidth), float(kWindowHeight), 0.0f, 1.0f);
+	Matrix4x4 cameraMatrix = mathFunc.MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.26f, 0.0f, 0.0f }, { 0.0f, 1.9f, -6.49f });
+	Matrix4x4 viewProjectionMatrix = mathFunc.Multiply(mathFunc.Inverse(cameraMatrix), projectionMatrix);
+	ScreenTransform screenTransform = mathFunc.MakeScreenTransform(viewProjectionMatrix, viewportMatrix);
+
+	Sphere sphere{ { 0.0f, 0.5f, 0.0f }, 0.8f };
+	AABB aabb{ { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } };
+	Plane plane{ { 0.0f, 1.0f, 0.0f }, 0.0f };
+	Triangle triangle{ { { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } } };
+	Vector3 bezier[3] = { { -0.8f, 0.58f, 1.0f }, { 1.76f, 1.0f, -0.3f }, { 0.94f, -0.7f, 2.3f } };
+
+	Measure("DrawGrid", buffer, [&]() { mathFunc.DrawGrid(screenTransform); });
+	Measure("DrawSphere", buffer, [&]() { mathFunc.DrawSphere(sphere, screenTransform, 0xFFFFFFFF); });
+	Measure("DrawAABB", buffer, [&]() { mathFunc.DrawAABB(aabb, screenTransform, 0xFFFFFFFF); });
+	Measure("DrawPlane", buffer, [&]() { mathFunc.DrawPlane(plane, screenTransform, 0xFFFFFFFF); });
+	Measure("DrawTriangle", buffer, [&]() { mathFunc.DrawTriangle(triangle, screenTransform, 0xFFFFFFFF); });
+	Measure("DrawBezier", buffer, [&]() { mathFunc.DrawBezier(bezier[0], bezier[1], bezier[2], screenTransform, 0xFFFFFFFF); });
+	Measure("DrawCatmullRom", buffer, [&]() { mathFunc.DrawCatmullRom(bezier[0], bezier[1], bezier[2], bezier[0], screenTransform, 0xFFFFFFFF); });
+
+	// カメラの前方の広い範囲にばらまいた形状。視錐台の無いScreenTransformでは全て描画される
+	std::mt19937 random(2024);
+	std::uniform_real_distribution<float> x(-30.0f, 30.0f), y(-3.0f, 5.0f), z(-4.0f, 20.0f), size(0.1f, 0.5f);
+	std::vector<float> sphereX(kSceneShapeCount), sphereY(kSceneShapeCount), sphereZ(kSceneShapeCount), sphereRadius(kSceneShapeCount);
+	std::vector<float> minX(kSceneShapeCount), minY(kSceneShapeCount), minZ(kSceneShapeCount), maxX(kSceneShapeCount), maxY(kSceneShapeCount), maxZ(kSceneShapeCount);
+	for (size_t i = 0; i < kSceneShapeCount; ++i)
+	{
+		sphereX[i] = x(random), sphereY[i] = y(random), sphereZ[i] = z(random), sphereRadius[i] = size(random);
+		minX[i] = x(random), minY[i] = y(random), minZ[i] = z(random);
+		maxX[i] = minX[i] + size(random), maxY[i] = minY[i] + size(random), maxZ[i] = minZ[i] + size(random);
+	}
+	ConstSphereSpan spheres{ sphereX.data(), sphereY.data(), sphereZ.data(), sphereRadius.data(), kSceneShapeCount };
+	ConstAABBSpan aabbs{ minX.data(), minY.data(), minZ.data(), maxX.data(), maxY.data(), maxZ.data(), kSceneShapeCount };
+	ScreenTransform noCullTransform{ screenTransform.matrix, {} };
+
+	Measure("Spheres/NoCull", buffer, [&]() { mathFunc.DrawSpheres(spheres, noCullTransform, 0xFFFFFFFF); }, kSceneRepeat);
+	Measure("Spheres/Culled", buffer, [&]() { mathFunc.DrawSpheres(spheres, screenTransform, 0xFFFFFFFF); }, kSceneRepeat);
+	Measure("AABBs/NoCull", buffer, [&]() { mathFunc.DrawAABBs(aabbs, noCullTransform, 0xFFFFFFFF); }, kSceneRepeat);
+	Measure("AABBs/Culled", buffer, [&]() { mathFunc.DrawAABBs(aabbs, screenTransform, 0xFFFFFFFF); }, kSceneRepeat);
+
+	return 0;
+}
@@ -0,0 +1,388 @@
+#include "BenchmarkRunner.h"
+#include "LineCommandBuffer.h"
+#include "MathFunction.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+// MathFunctionの公開関数ごとのマイクロベンチマーク
+//
+//   math_benchmark                                   全ケースを実行
+//   math_benchmark --filter IsCollision              名前で絞り込み
+//   math_benchmark --json result.json                結果をJSONで保存
+//   math_benchmark --compare Benchmark/baseline.json --threshold 10
+//                                                    基準値より10%以上遅いケースがあれば終了コード1
+//
+// 計測の前に結果の確認（RunChecks）を行い、誤りがあれば計測の後に終了コード1で終わる
+//
+// Benchmark/baseline.json はCMakeの既定設定(Release)で計測した値。計測環境が変わったら
+// --json Benchmark/baseline.json で作り直してからコミットする
+
+namespace
+{
+	const size_t kInputCount = BenchmarkRunner::kInputCount;
+	const size_t kBatchCount = 256;	// 一括処理ケースの1回あたりの要素数
+	const int kWindowWidth = 1280;
+	const int kWindowHeight = 720;
+
+	// 計測に使う乱数入力
+	struct Inputs
+	{
+		std::vector<Vector3> vectors1, vectors2, vectors3, vectors4;
+		std::vector<float> scalars, radians, ts;
+		std::vector<Matrix4x4> matrices1, matrices2, rigidMatrices;
+		std::vector<Sphere> spheres1, spheres2;
+		std::vector<Plane> planes;
+		std::vector<Segment> segments;
+		std::vector<Triangle> triangles;
+		std::vector<AABB> aabbs1, aabbs2;
+	};
+
+	Inputs MakeInputs(MathFunction& mathFunc)
+	{
+		std::mt19937 random(20240601);
+		std::uniform_real_distribution<float> position(-2.0f, 2.0f);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+		std::uniform_real_distribution<float> size(0.1f, 1.0f);
+		auto randomVector = [&]() { return Vector3{ position(random), position(random), position(random) }; };
+		auto randomAABB = [&]()
+			{
+				Vector3 center = randomVector();
+				Vector3 half = { size(random), size(random), size(random) };
+				return AABB{ mathFunc.Subtract(center, half), mathFunc.Add(center, half) };
+			};
+
+		Inputs inputs;
+		for (size_t i = 0; i < kInputCount; ++i)
+		{
+			inputs.vectors1.push_back(randomVector());
+			inputs.vectors2.push_back(randomVector());
+			inputs.vectors3.push_back(randomVector());
+			inputs.vectors4.push_back(randomVector());
+			inputs.scalars.push_back(position(random));
+			inputs.radians.push_back(angle(random));
+			inputs.ts.push_back(unit(random));
+			inputs.matrices1.push_back(mathFunc.MakeAffineMatrix({ size(random), size(random), size(random) }, { angle(random), angle(random), angle(random) }, randomVector()));
+			inputs.matrices2.push_back(mathFunc.MakeAffineMatrix({ size(random), size(random), size(random) }, { angle(random), angle(random), angle(random) }, randomVector()));
+			inputs.rigidMatrices.push_back(mathFunc.MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { angle(random), angle(random), angle(random) }, randomVector()));
+			inputs.spheres1.push_back({ randomVector(), size(random) });
+			inputs.spheres2.push_back({ randomVector(), size(random) });
+			inputs.planes.push_back({ mathFunc.Normalize(randomVector()), position(random) });
+			inputs.segments.push_back({ randomVector(), randomVector() });
+			inputs.triangles.push_back({ { randomVector(), randomVector(), randomVector() } });
+			inputs.aabbs1.push_back(randomAABB());
+			inputs.aabbs2.push_back(randomAABB());
+		}
+		return inputs;
+	}
+
+	// 計測とは別の結果の確認。見つかった誤りの数を返す（1つでもあれば終了コード1）
+	uint32_t RunChecks(MathFunction& mathFunc, const Inputs& in)
+	{
+		uint32_t failureCount = 0;
+
+		// 開始時点で重なっていれば、同じ速度（止まっている場合を含む）でも時刻0で当たる
+		uint32_t missedOverlapCount = 0;
+		float timeOfImpact = 0.0f;
+		const Vector3 zero{ 0.0f, 0.0f, 0.0f };
+		for (size_t i = 0; i < kInputCount; ++i)
+		{
+			if (!mathFunc.IsCollision(in.spheres1[i], in.spheres2[i]))
+			{
+				continue;
+			}
+			bool isRestHit = mathFunc.IsCollisionSwept(in.spheres1[i], zero, in.spheres2[i], zero, &timeOfImpact) && timeOfImpact == 0.0f;
+			bool isSameVelocityHit = mathFunc.IsCollisionSwept(in.spheres1[i], in.vectors2[i], in.spheres2[i], in.vectors2[i], &timeOfImpact) && timeOfImpact == 0.0f;
+			missedOverlapCount += (isRestHit && isSameVelocityHit) ? 0 : 1;
+		}
+		if (missedOverlapCount > 0)
+		{
+			std::fprintf(stderr, "check failed: Swept/Sphere-Sphere: %u overlapping pairs not reported at time 0\n", missedOverlapCount);
+			++failureCount;
+		}
+		// 3次に次数を上げた2次ベジエ（3次の係数がほぼ0）でも、曲線上の点がAABBと球に収まる
+		const uint32_t kCurveSampleCount = 64;
+		const float kBoundsTolerance = 1.0e-4f;
+		uint32_t outsideBoundsCount = 0;
+		for (size_t i = 0; i < kInputCount; ++i)
+		{
+			const Vector3& q0 = in.vectors1[i];
+			const Vector3& q1 = in.vectors2[i];
+			const Vector3& q2 = in.vectors3[i];
+			Vector3 p1 = mathFunc.Multiply(1.0f / 3.0f, mathFunc.Add(q0, mathFunc.Multiply(2.0f, q1)));
+			Vector3 p2 = mathFunc.Multiply(1.0f / 3.0f, mathFunc.Add(q2, mathFunc.Multiply(2.0f, q1)));
+			CubicCurve curve = mathFunc.MakeBezierCurve(q0, p1, p2, q2);
+			AABB bounds = mathFunc.MakeAABB(curve);
+			Sphere sphere = mathFunc.MakeSphere(curve);
+			for (uint32_t sample = 0; sample <= kCurveSampleCount; ++sample)
+			{
+				Vector3 point = mathFunc.Evaluate(curve, float(sample) / float(kCurveSampleCount));
+				bool isInsideAABB =
+					bounds.min.x - kBoundsTolerance <= point.x && point.x <= bounds.max.x + kBoundsTolerance &&
+					bounds.min.y - kBoundsTolerance <= point.y && point.y <= bounds.max.y + kBoundsTolerance &&
+					bounds.min.z - kBoundsTolerance <= point.z && point.z <= bounds.max.z + kBoundsTolerance;
+				bool isInsideSphere = mathFunc.Length(mathFunc.Subtract(point, sphere.center)) <= sphere.radius + kBoundsTolerance;
+				if (!isInsideAABB || !isInsideSphere)
+				{
+					++outsideBoundsCount;
+					break;
+				}
+			}
+		}
+		if (outsideBoundsCount > 0)
+		{
+			std::fprintf(stderr, "check failed: Curve/MakeAABB: %u elevated quadratic curves not inside their bounds\n", outsideBoundsCount);
+			++failureCount;
+		}
+		return failureCount;
+	}
+
+	void RunAll(BenchmarkRunner& runner, MathFunction& mathFunc, const Inputs& in)
+	{
+		/*----------Vector型の関数----------*/
+		runner.Run("Vector/Add", [&](size_t i) { return mathFunc.Add(in.vectors1[i], in.vectors2[i]); });
+		runner.Run("Vector/Subtract", [&](size_t i) { return mathFunc.Subtract(in.vectors1[i], in.vectors2[i]); });
+		runner.Run("Vector/Multiply", [&](size_t i) { return mathFunc.Multiply(in.scalars[i], in.vectors1[i]); });
+		runner.Run("Vector/Dot", [&](size_t i) { return mathFunc.Dot(in.vectors1[i], in.vectors2[i]); });
+		runner.Run("Vector/Length", [&](size_t i) { return mathFunc.Length(in.vectors1[i]); });
+		runner.Run("Vector/Normalize", [&](size_t i) { return mathFunc.Normalize(in.vectors1[i]); });
+		runner.Run("Vector/Transform", [&](size_t i) { return mathFunc.Transform(in.vectors1[i], in.matrices1[i]); });
+		runner.Run("Vector/Cross", [&](size_t i) { return mathFunc.Cross(in.vectors1[i], in.vectors2[i]); });
+		runner.Run("Vector/Project", [&](size_t i) { return mathFunc.Project(in.vectors1[i], in.vectors2[i]); });
+		runner.Run("Vector/ClosestPoint", [&](size_t i) { return mathFunc.ClosestPoint(in.vectors1[i], in.segments[i]); });
+		runner.Run("Vector/ClosestPoint(Ray)", [&](size_t i) { return mathFunc.ClosestPoint(in.vectors1[i], Ray{ in.segments[i].origin, in.segments[i].diff }); });
+		runner.Run("Vector/ClosestPoint(Line)", [&](size_t i) { return mathFunc.ClosestPoint(in.vectors1[i], Line{ in.segments[i].origin, in.segments[i].diff }); });
+		runner.Run("Vector/ClosestPoint(Triangle)", [&](size_t i) { return mathFunc.ClosestPoint(in.vectors1[i], in.triangles[i]); });
+		runner.Run("Vector/Perpendicular", [&](size_t i) { return mathFunc.Perpendicular(in.vectors1[i]); });
+		runner.Run("Vector/Lerp", [&](size_t i) { return mathFunc.Lerp(in.vectors1[i], in.vectors2[i], in.ts[i]); });
+		runner.Run("Vector/CatmullRom", [&](size_t i) { return mathFunc.CatmullRom(in.vectors1[i], in.vectors2[i], in.vectors3[i], in.vectors4[i], in.ts[i]); });
+
+		/*----------曲線の関数----------*/
+		std::vector<CubicCurve> curves(kInputCount);
+		for (size_t i = 0; i < kInputCount; ++i)
+		{
+			curves[i] = mathFunc.MakeCatmullRomCurve(in.vectors1[i], in.vectors2[i], in.vectors3[i], in.vectors4[i]);
+		}
+		runner.Run("Curve/MakeCatmullRomCurve", [&](size_t i) { return mathFunc.MakeCatmullRomCurve(in.vectors1[i], in.vectors2[i], in.vectors3[i], in.vectors4[i]); });
+		runner.Run("Curve/MakeBezierCurve", [&](size_t i) { return mathFunc.MakeBezierCurve(in.vectors1[i], in.vectors2[i], in.vectors3[i]); });
+		runner.Run("Curve/Evaluate", [&](size_t i) { return mathFunc.Evaluate(curves[i], in.ts[i]); });
+		runner.Run("Curve/EvaluateDerivative", [&](size_t i) { return mathFunc.EvaluateDerivative(curves[i], in.ts[i]); });
+		runner.Run("Curve/MakeSubCurve", [&](size_t i) { return mathFunc.MakeSubCurve(curves[i], 0.25f, in.ts[i]); });
+		runner.Run("Curve/MakeAABB", [&](size_t i) { return mathFunc.MakeAABB(curves[i]); });
+		runner.Run("Curve/MakeSphere", [&](size_t i) { return mathFunc.MakeSphere(curves[i]); });
+		runner.Run("Curve/ClosestPoint", [&](size_t i) { return mathFunc.ClosestPoint(in.vectors4[i], curves[i]); });
+		std::vector<Vector3> curveOut(kBatchCount);
+		runner.Run("Curve/EvaluateUniform(" + std::to_string(kBatchCount) + ")", [&](size_t i) { mathFunc.EvaluateUniform(curves[i], kBatchCount, curveOut.data()); return curveOut[kBatchCount / 2]; });
+
+		/*----------Vector型の一括処理関数(SoA)----------*/
+		std::vector<float> x1(kInputCount), y1(kInputCount), z1(kInputCount), x2(kInputCount), y2(kInputCount), z2(kInputCount);
+		std::vector<float> xo(kInputCount), yo(kInputCount), zo(kInputCount), so(kInputCount);
+		for (size_t i = 0; i < kInputCount; ++i)
+		{
+			x1[i] = in.vectors1[i].x; y1[i] = in.vectors1[i].y; z1[i] = in.vectors1[i].z;
+			x2[i] = in.vectors2[i].x; y2[i] = in.vectors2[i].y; z2[i] = in.vectors2[i].z;
+		}
+		// 入力番号からkBatchCount個ぶんの範囲を切り出す
+		auto span1 = [&](size_t i) { size_t o = i % (kInputCount - kBatchCount); return ConstVector3Span{ &x1[o], &y1[o], &z1[o], kBatchCount }; };
+		auto span2 = [&](size_t i) { size_t o = i % (kInputCount - kBatchCount); return ConstVector3Span{ &x2[o], &y2[o], &z2[o], kBatchCount }; };
+		Vector3Span out{ xo.data(), yo.data(), zo.data(), kBatchCount };
+		const std::string batch = "(" + std::to_string(kBatchCount) + ")";
+		runner.Run("Batch/Add" + batch, [&](size_t i) { mathFunc.Add(span1(i), span2(i), out); return xo[0]; });
+		runner.Run("Batch/Subtract" + batch, [&](size_t i) { mathFunc.Subtract(span1(i), span2(i), out); return xo[0]; });
+		runner.Run("Batch/Dot" + batch, [&](size_t i) { mathFunc.Dot(span1(i), span2(i), so.data()); return so[0]; });
+		runner.Run("Batch/Cross" + batch, [&](size_t i) { mathFunc.Cross(span1(i), span2(i), out); return xo[0]; });
+		runner.Run("Batch/Length" + batch, [&](size_t i) { mathFunc.Length(span1(i), so.data()); return so[0]; });
+		runner.Run("Batch/Normalize" + batch, [&](size_t i) { mathFunc.Normalize(span1(i), out); return xo[0]; });
+		runner.Run("Batch/TransformPoints" + batch, [&](size_t i) { mathFunc.TransformPoints(span1(i), in.matrices1[i], out); return xo[0]; });
+		runner.Run("Batch/TransformPoints(Affine)" + batch, [&](size_t i) { mathFunc.TransformPoints(span1(i), in.rigidMatrices[i], out); return xo[0]; });
+		std::vector<Vector3> vectorsOut(kBatchCount);
+		runner.Run("Batch/TransformPoints(AoS)" + batch, [&](size_t i) { mathFunc.TransformPoints(&in.vectors1[i % (kInputCount - kBatchCount)], kBatchCount, in.matrices1[i], vectorsOut.data()); return vectorsOut[0]; });
+		runner.Run("Batch/TransformPoints(AoS,Affine)" + batch, [&](size_t i) { mathFunc.TransformPoints(&in.vectors1[i % (kInputCount - kBatchCount)], kBatchCount, in.rigidMatrices[i], vectorsOut.data()); return vectorsOut[0]; });
+		std::vector<float> sphereX(kInputCount), sphereY(kInputCount), sphereZ(kInputCount), sphereRadius(kInputCount);
+		std::vector<float> minX(kInputCount), minY(kInputCount), minZ(kInputCount), maxX(kInputCount), maxY(kInputCount), maxZ(kInputCount);
+		for (size_t i = 0; i < kInputCount; ++i)
+		{
+			sphereX[i] = in.spheres2[i].center.x; sphereY[i] = in.spheres2[i].center.y; sphereZ[i] = in.spheres2[i].center.z; sphereRadius[i] = in.spheres2[i].radius;
+			minX[i] = in.aabbs2[i].min.x; minY[i] = in.aabbs2[i].min.y; minZ[i] = in.aabbs2[i].min.z;
+			maxX[i] = in.aabbs2[i].max.x; maxY[i] = in.aabbs2[i].max.y; maxZ[i] = in.aabbs2[i].max.z;
+		}
+		auto sphereSpan = [&](size_t i) { size_t o = i % (kInputCount - kBatchCount); return ConstSphereSpan{ &sphereX[o], &sphereY[o], &sphereZ[o], &sphereRadius[o], kBatchCount }; };
+		auto aabbSpan = [&](size_t i) { size_t o = i % (kInputCount - kBatchCount); return ConstAABBSpan{ &minX[o], &minY[o], &minZ[o], &maxX[o], &maxY[o], &maxZ[o], kBatchCount }; };
+		std::vector<uint32_t> maskOut(kBatchCount / 32), indicesOut(kBatchCount);
+		runner.Run("Batch/IsCollisionMask(Sphere-Sphere)" + batch, [&](size_t i) { mathFunc.IsCollisionMask(in.spheres1[i], sphereSpan(i), maskOut.data()); return maskOut[0]; });
+		runner.Run("Batch/IsCollisionMask(Sphere-AABB)" + batch, [&](size_t i) { mathFunc.IsCollisionMask(in.spheres1[i], aabbSpan(i), maskOut.data()); return maskOut[0]; });
+		runner.Run("Batch/IsCollisionMask(AABB-AABB)" + batch, [&](size_t i) { mathFunc.IsCollisionMask(in.aabbs1[i], aabbSpan(i), maskOut.data()); return maskOut[0]; });
+		runner.Run("Batch/IsCollisionMask(AABB-Sphere)" + batch, [&](size_t i) { mathFunc.IsCollisionMask(in.aabbs1[i], sphereSpan(i), maskOut.data()); return maskOut[0]; });
+		runner.Run("Batch/IsCollisionIndices(Sphere-Sphere)" + batch, [&](size_t i) { return mathFunc.IsCollisionIndices(in.spheres1[i], sphereSpan(i), indicesOut.data()); });
+		runner.Run("Batch/IsCollisionIndices(AABB-AABB)" + batch, [&](size_t i) { return mathFunc.IsCollisionIndices(in.aabbs1[i], aabbSpan(i), indicesOut.data()); });
+		std::vector<float> tEntersOut(kBatchCount);
+		runner.Run("Batch/IsCollisionMask(RayQuery-AABB)" + batch, [&](size_t i) { mathFunc.IsCollisionMask(mathFunc.MakeRayQuery(in.segments[i]), aabbSpan(i), maskOut.data()); return maskOut[0]; });
+		runner.Run("Batch/IsCollisionIndices(RayQuery-AABB)" + batch, [&](size_t i) { return mathFunc.IsCollisionIndices(mathFunc.MakeRayQuery(in.segments[i]), aabbSpan(i), indicesOut.data(), tEntersOut.data()); });
+		runner.Run("Batch/Evaluate(CubicCurve)" + batch, [&](size_t i) { mathFunc.Evaluate(curves[i], &in.ts[i % (kInputCount - kBatchCount)], out); return xo[0]; });
+		std::vector<Matrix4x4> matricesOut(kBatchCount);
+		runner.Run("Batch/MakeAffineMatrix" + batch, [&](size_t i) { mathFunc.MakeAffineMatrix(span1(i), span2(i), span1(i + 1), matricesOut.data()); return matricesOut[0]; });
+
+		/*----------Matrix型の関数----------*/
+		runner.Run("Matrix/Add", [&](size_t i) { return mathFunc.Add(in.matrices1[i], in.matrices2[i]); });
+		runner.Run("Matrix/Subtract", [&](size_t i) { return mathFunc.Subtract(in.matrices1[i], in.matrices2[i]); });
+		runner.Run("Matrix/Multiply", [&](size_t i) { return mathFunc.Multiply(in.matrices1[i], in.matrices2[i]); });
+		runner.Run("Matrix/Inverse", [&](size_t i) { return mathFunc.Inverse(in.matrices1[i]); });
+		runner.Run("Matrix/InverseAffine", [&](size_t i) { return mathFunc.InverseAffine(in.matrices1[i]); });
+		runner.Run("Matrix/InverseRigid", [&](size_t i) { return mathFunc.InverseRigid(in.rigidMatrices[i]); });
+		runner.Run("Matrix/Transpose", [&](size_t i) { return mathFunc.Transpose(in.matrices1[i]); });
+		runner.Run("Matrix/MakeIdentity", [&](size_t) { return mathFunc.MakeIdentity(); });
+		runner.Run("Matrix/MakeScaleMatrix", [&](size_t i) { return mathFunc.MakeScaleMatrix(in.vectors1[i]); });
+		runner.Run("Matrix/MakeRotateXMatrix", [&](size_t i) { return mathFunc.MakeRotateXMatrix(in.radians[i]); });
+		runner.Run("Matrix/MakeRotateYMatrix", [&](size_t i) { return mathFunc.MakeRotateYMatrix(in.radians[i]); });
+		runner.Run("Matrix/MakeRotateZMatrix", [&](size_t i) { return mathFunc.MakeRotateZMatrix(in.radians[i]); });
+		runner.Run("Matrix/MakeTranslateMatrix", [&](size_t i) { return mathFunc.MakeTranslateMatrix(in.vectors1[i]); });
+		runner.Run("Matrix/MakeAffineMatrix", [&](size_t i) { return mathFunc.MakeAffineMatrix(in.vectors1[i], in.vectors2[i], in.vectors3[i]); });
+		runner.Run("Matrix/MakePerspectiveFovMatrix", [&](size_t i) { return mathFunc.MakePerspectiveFovMatrix(0.45f + in.ts[i], 16.0f / 9.0f, 0.1f, 100.0f); });
+		runner.Run("Matrix/MakeOrthographicMatrix", [&](size_t i) { return mathFunc.MakeOrthographicMatrix(-in.ts[i] - 1.0f, 1.0f, 1.0f, -1.0f, 0.1f, 100.0f); });
+		runner.Run("Matrix/MakeViewportMatrix", [&](size_t i) { return mathFunc.MakeViewportMatrix(in.ts[i], 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f); });
+		runner.Run("Matrix/MakeScreenTransform", [&](size_t i) { return mathFunc.MakeScreenTransform(in.matrices1[i], in.matrices2[i]); });
+		runner.Run("Matrix/MakeFrustum", [&](size_t i) { return mathFunc.MakeFrustum(in.matrices1[i]); });
+
+		/*----------立体を描画する関数----------*/
+		// main.cppと同じカメラで、LineCommandBufferに記録する
+		LineCommandBuffer buffer(kWindowWidth, kWindowHeight);
+		mathFunc.SetDrawSink(&buffer);
+		Matrix4x4 projectionMatrix = mathFunc.MakePerspectiveFovMatrix(0.45f, float(kWindowWidth) / float(kWindowHeight), 0.1f, 100.0f);
+		Matrix4x4 viewportMatrix = mathFunc.MakeViewportMatrix(0.0f, 0.0f, float(kWindowWidth), float(kWindowHeight), 0.0f, 1.0f);
+		Matrix4x4 cameraMatrix = mathFunc.MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.26f, 0.0f, 0.0f }, { 0.0f, 1.9f, -6.49f });
+		ScreenTransform screenTransform = mathFunc.MakeScreenTransform(mathFunc.Multiply(mathFunc.Inverse(cameraMatrix), projectionMatrix), viewportMatrix);
+		runner.Run("Vector/Transform(ScreenTransform)", [&](size_t i) { return mathFunc.Transform(in.vectors1[i], screenTransform); });
+		auto drawn = [&]() { size_t count = buffer.GetLines().size(); buffer.Clear(); return count; };
+		runner.Run("Draw/DrawGrid", [&](size_t) { mathFunc.DrawGrid(screenTransform); return drawn(); });
+		runner.Run("Draw/DrawSphere", [&](size_t i) { mathFunc.DrawSphere(in.spheres1[i], screenTransform, 0xFFFFFFFF); return drawn(); });
+		runner.Run("Draw/DrawPlane", [&](size_t i) { mathFunc.DrawPlane(in.planes[i], screenTransform, 0xFFFFFFFF); return drawn(); });
+		runner.Run("Draw/DrawTriangle", [&](size_t i) { mathFunc.DrawTriangle(in.triangles[i], screenTransform, 0xFFFFFFFF); return drawn(); });
+		runner.Run("Draw/DrawAABB", [&](size_t i) { mathFunc.DrawAABB(in.aabbs1[i], screenTransform, 0xFFFFFFFF); return drawn(); });
+		runner.Run("Draw/DrawBezier", [&](size_t i) { mathFunc.DrawBezier(in.vectors1[i], in.vectors2[i], in.vectors3[i], screenTransform, 0xFFFFFFFF); return drawn(); });
+		runner.Run("Draw/DrawCatmullRom", [&](size_t i) { mathFunc.DrawCatmullRom(in.vectors1[i], in.vectors2[i], in.vectors3[i], in.vectors4[i], screenTransform, 0xFFFFFFFF); return drawn(); });
+		runner.Run("Draw/DrawControlPoint", [&](size_t i) { mathFunc.DrawControlPoint(in.vectors1[i], screenTransform); return drawn(); });
+		runner.Run("Draw/DrawSpheres" + batch, [&](size_t i) { mathFunc.DrawSpheres(sphereSpan(i), screenTransform, 0xFFFFFFFF); return drawn(); });
+		runner.Run("Draw/DrawAABBs" + batch, [&](size_t i) { mathFunc.DrawAABBs(aabbSpan(i), screenTransform, 0xFFFFFFFF); return drawn(); });
+		runner.Run("Batch/IsCollisionMask(Frustum-Sphere)" + batch, [&](size_t i) { mathFunc.IsCollisionMask(screenTransform.frustum, sphereSpan(i), maskOut.data()); return maskOut[0]; });
+		runner.Run("Batch/IsCollisionMask(Frustum-AABB)" + batch, [&](size_t i) { mathFunc.IsCollisionMask(screenTransform.frustum, aabbSpan(i), maskOut.data()); return maskOut[0]; });
+		runner.Run("Batch/IsCollisionIndices(Frustum-AABB)" + batch, [&](size_t i) { return mathFunc.IsCollisionIndices(screenTransform.frustum, aabbSpan(i), indicesOut.data()); });
+		runner.Run("IsCollision/Frustum-Sphere", [&](size_t i) { return mathFunc.IsCollision(screenTransform.frustum, in.spheres1[i]); });
+		runner.Run("IsCollision/Frustum-AABB", [&](size_t i) { return mathFunc.IsCollision(screenTransform.frustum, in.aabbs1[i]); });
+		runner.Run("IsCollision/Curve-Sphere", [&](size_t i) { return mathFunc.IsCollision(curves[i], in.spheres1[i]); });
+		runner.Run("IsCollision/Curve-AABB", [&](size_t i) { return mathFunc.IsCollision(curves[i], in.aabbs1[i]); });
+		mathFunc.SetDrawSink(nullptr);
+
+		/*----------衝突判定を取る関数----------*/
+		std::vector<RayQuery> queries(kInputCount);
+		std::vector<Ray> rays(kInputCount);
+		std::vector<Line> lines(kInputCount);
+		for (size_t i = 0; i < kInputCount; ++i)
+		{
+			queries[i] = mathFunc.MakeRayQuery(in.segments[i]);
+			rays[i] = { in.segments[i].origin, in.segments[i].diff };
+			lines[i] = { in.segments[i].origin, in.segments[i].diff };
+		}
+		runner.Run("IsCollision/Sphere-Sphere", [&](size_t i) { return mathFunc.IsCollision(in.spheres1[i], in.spheres2[i]); });
+		runner.Run("IsCollision/Sphere-Plane", [&](size_t i) { return mathFunc.IsCollision(in.spheres1[i], in.planes[i]); });
+		runner.Run("IsCollision/Segment-Plane", [&](size_t i) { return mathFunc.IsCollision(in.segments[i], in.planes[i]); });
+		runner.Run("IsCollision/Ray-Plane", [&](size_t i) { return mathFunc.IsCollision(rays[i], in.planes[i]); });
+		runner.Run("IsCollision/Line-Plane", [&](size_t i) { return mathFunc.IsCollision(lines[i], in.planes[i]); });
+		runner.Run("IsCollision/Sphere-Segment", [&](size_t i) { return mathFunc.IsCollision(in.spheres1[i], in.segments[i]); });
+		runner.Run("IsCollision/Sphere-Ray", [&](size_t i) { return mathFunc.IsCollision(in.spheres1[i], rays[i]); });
+		runner.Run("IsCollision/Sphere-Line", [&](size_t i) { return mathFunc.IsCollision(in.spheres1[i], lines[i]); });
+		runner.Run("IsCollision/Triangle-Segment", [&](size_t i) { return mathFunc.IsCollision(in.triangles[i], in.segments[i]); });
+		TriangleHit triangleHit{};
+		runner.Run("IsCollision/Triangle-Segment(Hit)", [&](size_t i) { mathFunc.IsCollision(in.triangles[i], in.segments[i], &triangleHit); return triangleHit; });
+		runner.Run("IsCollision/Triangle-Ray", [&](size_t i) { return mathFunc.IsCollision(in.triangles[i], rays[i]); });
+		runner.Run("IsCollision/Triangle-Line", [&](size_t i) { return mathFunc.IsCollision(in.triangles[i], lines[i]); });
+		runner.Run("IsCollision/Triangle-Sphere", [&](size_t i) { return mathFunc.IsCollision(in.triangles[i], in.spheres1[i]); });
+		runner.Run("IsCollision/Triangle-AABB", [&](size_t i) { return mathFunc.IsCollision(in.triangles[i], in.aabbs1[i]); });
+		runner.Run("IsCollision/AABB-AABB", [&](size_t i) { return mathFunc.IsCollision(in.aabbs1[i], in.aabbs2[i]); });
+		runner.Run("IsCollision/AABB-Sphere", [&](size_t i) { return mathFunc.IsCollision(in.aabbs1[i], in.spheres1[i]); });
+		runner.Run("IsCollision/AABB-Plane", [&](size_t i) { return mathFunc.IsCollision(in.aabbs1[i], in.planes[i]); });
+		runner.Run("IsCollision/AABB-Segment", [&](size_t i) { return mathFunc.IsCollision(in.aabbs1[i], in.segments[i]); });
+		runner.Run("IsCollision/AABB-Ray", [&](size_t i) { return mathFunc.IsCollision(in.aabbs1[i], rays[i]); });
+		runner.Run("IsCollision/AABB-Line", [&](size_t i) { return mathFunc.IsCollision(in.aabbs1[i], lines[i]); });
+		runner.Run("IsCollision/AABB-RayQuery", [&](size_t i) { return mathFunc.IsCollision(in.aabbs1[i], queries[i]); });
+		runner.Run("IsCollision/MakeRayQuery", [&](size_t i) { return mathFunc.MakeRayQuery(in.segments[i]); });
+		ContactManifold contact{};
+		runner.Run("IsCollision/Sphere-Sphere(Contact)", [&](size_t i) { mathFunc.IsCollision(in.spheres1[i], in.spheres2[i], &contact); return contact.depth; });
+		runner.Run("IsCollision/Sphere-Plane(Contact)", [&](size_t i) { mathFunc.IsCollision(in.spheres1[i], in.planes[i], &contact); return contact.depth; });
+		runner.Run("IsCollision/AABB-AABB(Contact)", [&](size_t i) { mathFunc.IsCollision(in.aabbs1[i], in.aabbs2[i], &contact); return contact.depth; });
+		runner.Run("IsCollision/AABB-Sphere(Contact)", [&](size_t i) { mathFunc.IsCollision(in.aabbs1[i], in.spheres1[i], &contact); return contact.depth; });
+
+		/*----------移動する形状の衝突判定(連続判定)----------*/
+		float timeOfImpact = 0.0f;
+		runner.Run("Swept/Sphere-Plane", [&](size_t i) { mathFunc.IsCollisionSwept(in.spheres1[i], in.vectors2[i], in.planes[i], &timeOfImpact); return timeOfImpact; });
+		runner.Run("Swept/Sphere-Sphere", [&](size_t i) { mathFunc.IsCollisionSwept(in.spheres1[i], in.vectors2[i], in.spheres2[i], in.vectors3[i], &timeOfImpact); return timeOfImpact; });
+		runner.Run("Swept/Sphere-Sphere(SameVelocity)", [&](size_t i) { mathFunc.IsCollisionSwept(in.spheres1[i], in.vectors2[i], in.spheres2[i], in.vectors2[i], &timeOfImpact); return timeOfImpact; });
+		runner.Run("Swept/Sphere-AABB", [&](size_t i) { mathFunc.IsCollisionSwept(in.spheres1[i], in.vectors2[i], in.aabbs1[i], in.vectors3[i], &timeOfImpact); return timeOfImpact; });
+		runner.Run("Swept/AABB-AABB", [&](size_t i) { mathFunc.IsCollisionSwept(in.aabbs1[i], in.vectors2[i], in.aabbs2[i], in.vectors3[i], &timeOfImpact); return timeOfImpact; });
+		// 比較用：同じ移動を8分割して静的な判定を繰り返す場合
+		runner.Run("Swept/Sphere-AABB(Substep8)", [&](size_t i)
+			{
+				for (int step = 1; step <= 8; ++step)
+				{
+					float t = float(step) / 8.0f;
+					Vector3 offset = mathFunc.Multiply(t, mathFunc.Subtract(in.vectors2[i], in.vectors3[i]));
+					if (mathFunc.IsCollision(in.aabbs1[i], Sphere{ mathFunc.Add(in.spheres1[i].center, offset), in.spheres1[i].radius }))
+					{
+						return t;
+					}
+				}
+				return 1.0f;
+			});
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string jsonPath;
+	std::string comparePath;
+	std::string filter;
+	double thresholdPercent = 10.0;
+	double minTimeSeconds = 0.05;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--json" && hasValue) { jsonPath = argv[++i]; }
+		else if (arg == "--compare" && hasValue) { comparePath = argv[++i]; }
+		else if (arg == "--threshold" && hasValue) { thresholdPercent = std::atof(argv[++i]); }
+		else if (arg == "--min-time" && hasValue) { minTimeSeconds = std::atof(argv[++i]); }
+		else if (arg == "--filter" && hasValue) { filter = argv[++i]; }
+		else
+		{
+			std::fprintf(stderr, "usage: %s [--filter NAME] [--min-time SEC] [--json OUT] [--compare BASELINE] [--threshold PERCENT]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	MathFunction mathFunc;
+	Inputs inputs = MakeInputs(mathFunc);
+	const uint32_t failureCount = RunChecks(mathFunc, inputs);
+	BenchmarkRunner runner(minTimeSeconds, filter);
+	RunAll(runner, mathFunc, inputs);
+
+	if (!jsonPath.empty() && !BenchmarkRunner::WriteJson(jsonPath, runner.GetResults()))
+	{
+		std::fprintf(stderr, "failed to write %s\n", jsonPath.c_str());
+		return 2;
+	}
+	if (!comparePath.empty())
+	{
+		std::vector<BenchmarkResult> baseline;
+		if (!BenchmarkRunner::ReadJson(comparePath, baseline))
+		{
+			std::fprintf(stderr, "failed to read %s\n", comparePath.c_str());
+			return 2;
+		}
+		if (BenchmarkRunner::Compare(baseline, runner.GetResults(), thresholdPercent) > 0)
+		{
+			return 1;
+		}
+	}
+	return failureCount > 0 ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+#include "MathFunction.h"
+#include "MeshRaycaster.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// メッシュへのレイキャストの計測。総当たりと同じ三角形・同じtが得られるかも確認する
+
+namespace
+{
+	const uint32_t kGridSizes[] = { 32, 128, 320 };	// 格子の一辺（三角形数は 2 × 一辺²）
+	const uint32_t kRayCount = 10000;
+	const uint32_t kBruteForceRayCount = 200;		// 総当たりで確認するレイの数
+
+	// 波打った高さの格子を三角形に分割する
+	std::vector<Triangle> MakeTerrain(uint32_t gridSize)
+	{
+		auto height = [](float x, float z) { return 0.3f * std::sin(x * 1.7f) * std::cos(z * 1.3f); };
+		const float cellSize = 10.0f / gridSize;
+		std::vector<Triangle> triangles;
+		triangles.reserve(size_t(gridSize) * gridSize * 2);
+		for (uint32_t zIndex = 0; zIndex < gridSize; ++zIndex)
+		{
+			for (uint32_t xIndex = 0; xIndex < gridSize; ++xIndex)
+			{
+				float x0 = -5.0f + xIndex * cellSize, x1 = x0 + cellSize;
+				float z0 = -5.0f + zIndex * cellSize, z1 = z0 + cellSize;
+				Vector3 a{ x0, height(x0, z0), z0 }, b{ x1, height(x1, z0), z0 };
+				Vector3 c{ x0, height(x0, z1), z1 }, d{ x1, height(x1, z1), z1 };
+				triangles.push_back(Triangle{ { a, b, c } });
+				triangles.push_back(Triangle{ { b, d, c } });
+			}
+		}
+		return triangles;
+	}
+
+	// 全ての三角形を調べて最も近い交点を求める
+	bool BruteForceRaycast(MathFunction& mathFunc, const std::vector<Triangle>& triangles, const Segment& segment, MeshRaycastHit* hit)
+	{
+		bool isHit = false;
+		for (uint32_t i = 0; i < triangles.size(); ++i)
+		{
+			TriangleHit candidate{};
+			if (mathFunc.IsCollision(triangles[i], segment, &candidate) && (!isHit || candidate.t < hit->hit.t))
+			{
+				hit->triangleIndex = i;
+				hit->hit = candidate;
+				isHit = true;
+			}
+		}
+		return isHit;
+	}
+}
+
+int main()
+{
+	MathFunction mathFunc;
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> position(-6.0f, 6.0f);
+	std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+
+	std::printf("%-10s %-22s %12s %10s\n", "triangles", "case", "us/ray", "hits");
+	for (uint32_t gridSize : kGridSizes)
+	{
+		std::vector<Triangle> triangles = MakeTerrain(gridSize);
+		const uint32_t triangleCount = uint32_t(triangles.size());
+
+		// 上から斜めに地面を狙う線分
+		std::vector<Segment> segments(kRayCount);
+		for (Segment& segment : segments)
+		{
+			segment.origin = { position(random), 3.0f, position(random) };
+			segment.diff = { direction(random) * 4.0f, -6.0f, direction(random) * 4.0f };
+		}
+
+		MeshRaycaster raycaster;
+		auto start = std::chrono::steady_clock::now();
+		raycaster.Build(triangles.data(), triangleCount);
+		auto end = std::chrono::steady_clock::now();
+		std::printf("%-10u %-22s %12.1f ms\n", triangleCount, "Build", std::chrono::duration<double, std::milli>(end - start).count());
+
+		uint32_t hitCount = 0;
+		MeshRaycastHit hit{};
+		start = std::chrono::steady_clock::now();
+		for (const Segment& segment : segments)
+		{
+			hitCount += raycaster.Raycast(segment, &hit) ? 1 : 0;
+		}
+		end = std::chrono::steady_clock::now();
+		std::printf("%-10u %-22s %12.3f %10u\n", triangleCount, "BVH", std::chrono::duration<double, std::micro>(end - start).count() / kRayCount, hitCount);
+
+		uint32_t bruteHitCount = 0;
+		uint32_t mismatchCount = 0;
+		start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < kBruteForceRayCount; ++i)
+		{
+			MeshRaycastHit bruteHit{};
+			bool isBruteHit = BruteForceRaycast(mathFunc, triangles, segments[i], &bruteHit);
+			bool isHit = raycaster.Raycast(segments[i], &hit);
+			bruteHitCount += isBruteHit ? 1 : 0;
+			mismatchCount += (isBruteHit != isHit || (isHit && bruteHit.hit.t != hit.hit.t)) ? 1 : 0;
+		}
+		end = std::chrono::steady_clock::now();
+		std::printf("%-10u %-22s %12.3f %10u  (%u of %u rays differ)\n", triangleCount, "BruteForce", std::chrono::duration<double, std::micro>(end - start).count() / kBruteForceRayCount,
+			bruteHitCount, mismatchCount, kBruteForceRayCount);
+	}
+	return 0;
+}
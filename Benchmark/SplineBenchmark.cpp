@@ -0,0 +1,133 @@
+#include "CatmullRomSpline.h"
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// CatmullRomSplineの計測
+//
+//   spline_benchmark              制御点256個の閉じた経路を、1万体のエージェントが一定速度で進む
+//   spline_benchmark 100000       エージェント数を指定
+//
+// 1フレームの全エージェントの位置を求める時間、経路の近くの点からの最近接点を求める時間と、
+// 制御点を1つ動かしたときの差分の作り直し（影響する区間だけ）と全体の作り直しの時間を表示する
+
+namespace
+{
+	const uint32_t kDefaultAgentCount = 10000;
+	const uint32_t kControlPointCount = 256;
+	const int kFrameCount = 100;
+	const int kEditCount = 1000;
+
+	template<class Function>
+	double MeasureMicroseconds(int repeat, Function function)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < repeat; ++i)
+		{
+			function(i);
+		}
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::micro>(end - start).count() / repeat;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const uint32_t agentCount = argc > 1 ? uint32_t(std::strtoul(argv[1], nullptr, 10)) : kDefaultAgentCount;
+	std::mt19937 random(12345);
+	std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+
+	// 円の周りに揺らした制御点を置いた閉じた経路
+	std::vector<Vector3> points(kControlPointCount);
+	for (uint32_t i = 0; i < kControlPointCount; ++i)
+	{
+		float angle = 6.2831853f * float(i) / float(kControlPointCount);
+		points[i] = { 100.0f * std::cos(angle) + jitter(random), jitter(random), 100.0f * std::sin(angle) + jitter(random) };
+	}
+
+	for (CatmullRomType type : { CatmullRomType::Uniform, CatmullRomType::Centripetal })
+	{
+		CatmullRomSpline spline;
+		spline.SetControlPoints(points.data(), kControlPointCount, type, true);
+		spline.Update();
+		std::printf("%s: control points %u, length %.2f, agents %u\n", type == CatmullRomType::Uniform ? "uniform" : "centripetal", kControlPointCount, spline.GetLength(), agentCount);
+
+		std::vector<float> distances(agentCount);
+		std::vector<float> speeds(agentCount);
+		std::uniform_real_distribution<float> start(0.0f, spline.GetLength());
+		std::uniform_real_distribution<float> speed(0.5f, 2.0f);
+		for (uint32_t i = 0; i < agentCount; ++i)
+		{
+			distances[i] = start(random);
+			speeds[i] = speed(random);
+		}
+		std::vector<Vector3> positions(agentCount);
+		double frameUs = MeasureMicroseconds(kFrameCount, [&](int)
+			{
+				for (uint32_t i = 0; i < agentCount; ++i)
+				{
+					distances[i] += speeds[i];
+				}
+				spline.EvaluateAtDistances(distances.data(), agentCount, positions.data());
+			});
+		std::printf("  %-24s %10.1f us/frame %8.1f ns/agent\n", "EvaluateAtDistances", frameUs, frameUs * 1000.0 / agentCount);
+
+		double incrementalUs = MeasureMicroseconds(kEditCount, [&](int i)
+			{
+				uint32_t index = uint32_t(i * 37) % kControlPointCount;
+				Vector3 point = spline.GetControlPoint(index);
+				point.y += 0.01f;
+				spline.SetControlPoint(index, point);
+				spline.Update();
+			});
+		double fullUs = MeasureMicroseconds(kEditCount / 10, [&](int)
+			{
+				spline.SetControlPoints(points.data(), kControlPointCount, type, true);
+				spline.Update();
+			});
+		// 最近接点。境界で区間を除外するものと、曲線を細かく刻んで総当たりするもの
+		const uint32_t kQueryCount = 1000;
+		const uint32_t kDenseSampleCount = 64;	//総当たりで1区間を刻む数
+		std::vector<Vector3> queries(kQueryCount);
+		for (Vector3& query : queries)
+		{
+			query = spline.EvaluateAtDistance(start(random));
+			query = { query.x + 5.0f * jitter(random), query.y + 5.0f * jitter(random), query.z + 5.0f * jitter(random) };
+		}
+		MathFunction mathFunc;
+		double checksum = 0.0;	//両者のxの差の合計（刻みの粗さぶんだけずれる）
+		double prunedUs = MeasureMicroseconds(kQueryCount, [&](int i)
+			{
+				checksum += spline.ClosestPoint(queries[i]).x;
+			});
+		double denseUs = MeasureMicroseconds(kQueryCount, [&](int i)
+			{
+				float bestDistanceSq = FLT_MAX;
+				Vector3 best{};
+				for (uint32_t segment = 0; segment < spline.GetSegmentCount(); ++segment)
+				{
+					for (uint32_t sample = 0; sample <= kDenseSampleCount; ++sample)
+					{
+						Vector3 point = mathFunc.Evaluate(spline.GetSegment(segment), float(sample) / float(kDenseSampleCount));
+						Vector3 diff = mathFunc.Subtract(point, queries[i]);
+						if (mathFunc.Dot(diff, diff) < bestDistanceSq)
+						{
+							bestDistanceSq = mathFunc.Dot(diff, diff);
+							best = point;
+						}
+					}
+				}
+				checksum -= best.x;
+			});
+		std::printf("  %-24s %10.2f us\n", "ClosestPoint", prunedUs);
+		std::printf("  %-24s %10.2f us (%.1fx, x diff %.3f)\n", "ClosestPoint(dense)", denseUs, denseUs / prunedUs, checksum);
+
+		std::printf("  %-24s %10.2f us\n", "SetControlPoint+Update", incrementalUs);
+		std::printf("  %-24s %10.2f us (%.1fx)\n\n", "SetControlPoints+Update", fullUs, fullUs / incrementalUs);
+	}
+	return 0;
+}
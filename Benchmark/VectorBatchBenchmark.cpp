@@ -0,0 +1,143 @@
+#include "MathFunction.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Vector3の一括処理(SoA)とスカラー版の比較ベンチマーク
+// 結果の一致(ULP差)もあわせて確認する
+
+namespace
+{
+	const size_t kCount = 1 << 16;	// 点群の要素数
+	const int kRepeat = 200;		// 計測の繰り返し回数
+
+	volatile float gSink;			// 最適化で計算が消されないようにするための書き込み先
+
+	// 2つのfloatの差を、基準値の1ULPを単位として表す
+	// 桁落ちするDot/Crossは結果ではなく最大の積の項を基準にする（MathFunction.hの許容誤差の定義）
+	float UlpError(float a, float b, float reference)
+	{
+		if (a == b) { return 0.0f; }
+		float magnitude = std::max(std::fabs(reference), std::max(std::fabs(a), std::fabs(b)));
+		float ulp = std::nextafter(magnitude, INFINITY) - magnitude;
+		return std::fabs(a - b) / ulp;
+	}
+
+	template<class Function>
+	double MeasureNsPerElement(Function function)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < kRepeat; ++r)
+		{
+			function();
+		}
+		auto end = std::chrono::steady_clock::now();
+		double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+		return ns / (double(kRepeat) * double(kCount));
+	}
+
+	void Report(const char* name, double scalarNs, double batchNs, float maxUlp)
+	{
+		std::printf("%-10s scalar %7.3f ns/elem  batch %7.3f ns/elem  speedup x%5.2f  maxULP %.2f\n",
+			name, scalarNs, batchNs, scalarNs / batchNs, maxUlp);
+	}
+}
+
+int main()
+{
+	MathFunction mathFunc;
+	std::mt19937 random(12345);
+	std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+
+	// 同じ点群をAoSとSoAの両方で用意する
+	std::vector<Vector3> aos1(kCount), aos2(kCount), aosOut(kCount);
+	std::vector<float> x1(kCount), y1(kCount), z1(kCount), x2(kCount), y2(kCount), z2(kCount);
+	std::vector<float> xo(kCount), yo(kCount), zo(kCount), so(kCount);
+	std::vector<float> scalarOut(kCount);
+	for (size_t i = 0; i < kCount; ++i)
+	{
+		aos1[i] = { distribution(random), distribution(random), distribution(random) };
+		aos2[i] = { distribution(random), distribution(random), distribution(random) };
+		x1[i] = aos1[i].x; y1[i] = aos1[i].y; z1[i] = aos1[i].z;
+		x2[i] = aos2[i].x; y2[i] = aos2[i].y; z2[i] = aos2[i].z;
+	}
+	ConstVector3Span v1{ x1.data(), y1.data(), z1.data(), kCount };
+	ConstVector3Span v2{ x2.data(), y2.data(), z2.data(), kCount };
+	Vector3Span out{ xo.data(), yo.data(), zo.data(), kCount };
+
+	// 各要素の基準値（0なら結果そのものが基準）
+	std::vector<float> reference(kCount, 0.0f);
+	auto setCrossReference = [&]()
+		{
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				const Vector3& a = aos1[i];
+				const Vector3& b = aos2[i];
+				reference[i] = std::max({ std::fabs(a.x * b.y), std::fabs(a.y * b.x), std::fabs(a.y * b.z),
+					std::fabs(a.z * b.y), std::fabs(a.z * b.x), std::fabs(a.x * b.z) });
+			}
+		};
+	auto setDotReference = [&]()
+		{
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				reference[i] = std::max({ std::fabs(aos1[i].x * aos2[i].x), std::fabs(aos1[i].y * aos2[i].y), std::fabs(aos1[i].z * aos2[i].z) });
+			}
+		};
+	auto clearReference = [&]() { std::fill(reference.begin(), reference.end(), 0.0f); };
+
+	// ベクトルを返す関数のULP差
+	auto maxUlpVector = [&]()
+		{
+			float maxUlp = 0.0f;
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				maxUlp = std::max(maxUlp, UlpError(aosOut[i].x, xo[i], reference[i]));
+				maxUlp = std::max(maxUlp, UlpError(aosOut[i].y, yo[i], reference[i]));
+				maxUlp = std::max(maxUlp, UlpError(aosOut[i].z, zo[i], reference[i]));
+			}
+			return maxUlp;
+		};
+	// スカラーを返す関数のULP差
+	auto maxUlpScalar = [&]()
+		{
+			float maxUlp = 0.0f;
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				maxUlp = std::max(maxUlp, UlpError(scalarOut[i], so[i], reference[i]));
+			}
+			return maxUlp;
+		};
+
+	double scalarNs, batchNs;
+
+	scalarNs = MeasureNsPerElement([&]() { for (size_t i = 0; i < kCount; ++i) { aosOut[i] = mathFunc.Add(aos1[i], aos2[i]); } gSink = aosOut[0].x; });
+	batchNs = MeasureNsPerElement([&]() { mathFunc.Add(v1, v2, out); gSink = xo[0]; });
+	Report("Add", scalarNs, batchNs, maxUlpVector());
+
+	scalarNs = MeasureNsPerElement([&]() { for (size_t i = 0; i < kCount; ++i) { aosOut[i] = mathFunc.Subtract(aos1[i], aos2[i]); } gSink = aosOut[0].x; });
+	batchNs = MeasureNsPerElement([&]() { mathFunc.Subtract(v1, v2, out); gSink = xo[0]; });
+	Report("Subtract", scalarNs, batchNs, maxUlpVector());
+
+	scalarNs = MeasureNsPerElement([&]() { for (size_t i = 0; i < kCount; ++i) { scalarOut[i] = mathFunc.Dot(aos1[i], aos2[i]); } gSink = scalarOut[0]; });
+	batchNs = MeasureNsPerElement([&]() { mathFunc.Dot(v1, v2, so.data()); gSink = so[0]; });
+	setDotReference();
+	Report("Dot", scalarNs, batchNs, maxUlpScalar());
+
+	scalarNs = MeasureNsPerElement([&]() { for (size_t i = 0; i < kCount; ++i) { aosOut[i] = mathFunc.Cross(aos1[i], aos2[i]); } gSink = aosOut[0].x; });
+	batchNs = MeasureNsPerElement([&]() { mathFunc.Cross(v1, v2, out); gSink = xo[0]; });
+	setCrossReference();
+	Report("Cross", scalarNs, batchNs, maxUlpVector());
+	clearReference();
+
+	scalarNs = MeasureNsPerElement([&]() { for (size_t i = 0; i < kCount; ++i) { scalarOut[i] = mathFunc.Length(aos1[i]); } gSink = scalarOut[0]; });
+	batchNs = MeasureNsPerElement([&]() { mathFunc.Length(v1, so.data()); gSink = so[0]; });
+	Report("Length", scalarNs, batchNs, maxUlpScalar());
+
+	scalarNs = MeasureNsPerElement([&]() { for (size_t i = 0; i < kCount; ++i) { aosOut[i] = mathFunc.Normalize(aos1[i]); } gSink = aosOut[0].x; });
+	batchNs = MeasureNsPerElement([&]() { mathFunc.Normalize(v1, out); gSink = xo[0]; });
+	Report("Normalize", scalarNs, batchNs, maxUlpVector());
+
+	return 0;
+}
@@ -0,0 +1,335 @@
+#include "CatmullRomSpline.h"
+#include <algorithm>
+#include <assert.h>
+#include <cfloat>
+#include <cmath>
+
+void CatmullRomSpline::SetControlPoints(const Vector3* points, uint32_t count, CatmullRomType type, bool isLoop)
+{
+	assert(count >= 2);
+	controlPoints_.assign(points, points + count);
+	type_ = type;
+	isLoop_ = isLoop;
+
+	const uint32_t segmentCount = isLoop ? count : count - 1;
+	segments_.resize(segmentCount);
+	segmentAABBs_.resize(segmentCount);
+	segmentSpheres_.resize(segmentCount);
+	arcLengths_.resize(size_t(segmentCount) * (kArcLengthSampleCount + 1));
+	speeds_.resize(arcLengths_.size());
+	segmentStarts_.assign(size_t(segmentCount) + 1, 0.0f);
+	isSegmentDirty_.assign(segmentCount, 0);
+	dirtySegments_.clear();
+	for (uint32_t segment = 0; segment < segmentCount; ++segment)
+	{
+		MarkDirty(segment);
+	}
+}
+
+void CatmullRomSpline::SetControlPoint(uint32_t index, const Vector3& point)
+{
+	assert(index < controlPoints_.size());
+	controlPoints_[index] = point;
+
+	// 区間iは制御点i-1～i+2で決まるので、影響するのは区間index-2～index+1
+	const int64_t segmentCount = int64_t(segments_.size());
+	for (int64_t segment = int64_t(index) - 2; segment <= int64_t(index) + 1; ++segment)
+	{
+		if (isLoop_)
+		{
+			MarkDirty(uint32_t((segment % segmentCount + segmentCount) % segmentCount));
+		}
+		else if (0 <= segment && segment < segmentCount)
+		{
+			MarkDirty(uint32_t(segment));
+		}
+	}
+}
+
+void CatmullRomSpline::Update()
+{
+	if (dirtySegments_.empty())
+	{
+		return;
+	}
+
+	for (uint32_t segment : dirtySegments_)
+	{
+		BuildSegment(segment);
+		isSegmentDirty_[segment] = 0;
+	}
+
+	// 区間の始点までの長さは、作り直した最初の区間から後ろだけ足し直す
+	const uint32_t first = *std::min_element(dirtySegments_.begin(), dirtySegments_.end());
+	for (uint32_t segment = first; segment < segments_.size(); ++segment)
+	{
+		segmentStarts_[segment + 1] = segmentStarts_[segment] + arcLengths_[size_t(segment) * (kArcLengthSampleCount + 1) + kArcLengthSampleCount];
+	}
+	dirtySegments_.clear();
+}
+
+Vector3 CatmullRomSpline::Evaluate(float parameter) const
+{
+	assert(IsUpToDate());
+	const uint32_t segmentCount = GetSegmentCount();
+	parameter = std::clamp(parameter, 0.0f, float(segmentCount));
+	const uint32_t segment = std::min(uint32_t(parameter), segmentCount - 1);
+	return mathFunc_.Evaluate(segments_[segment], parameter - float(segment));
+}
+
+float CatmullRomSpline::GetParameterAtDistance(float distance) const
+{
+	assert(IsUpToDate());
+	const uint32_t segmentCount = GetSegmentCount();
+	const float length = segmentStarts_[segmentCount];
+	if (!(length > 0.0f))
+	{
+		return 0.0f;
+	}
+	if (isLoop_)
+	{
+		distance = std::fmod(distance, length);
+		if (distance < 0.0f)
+		{
+			distance += length;
+		}
+	}
+	distance = std::clamp(distance, 0.0f, length);
+
+	// 区間を探し、区間の弧長表の中で挟まれる2点を探す
+	const uint32_t segment = std::min(uint32_t(std::upper_bound(segmentStarts_.begin() + 1, segmentStarts_.end(), distance) - (segmentStarts_.begin() + 1)), segmentCount - 1);
+	const float localDistance = distance - segmentStarts_[segment];
+	const size_t tableBegin = size_t(segment) * (kArcLengthSampleCount + 1);
+	const float* table = arcLengths_.data() + tableBegin;
+	const uint32_t sample = std::min(uint32_t(std::upper_bound(table + 1, table + kArcLengthSampleCount + 1, localDistance) - (table + 1)), kArcLengthSampleCount - 1);
+	const float sampleLength = table[sample + 1] - table[sample];
+	if (!(sampleLength > 0.0f))
+	{
+		return float(segment) + float(sample) / float(kArcLengthSampleCount);
+	}
+
+	// 距離→tの対応を、両端の傾き dt/ds = 1/速さ のエルミート補間で求める（線形補間だと表の点ごとに速さが跳ぶ）。
+	// 傾きを[0,3]に収めると単調になる。速さが0に近い点では傾きが3で頭打ちになる
+	const float* speeds = speeds_.data() + tableBegin;
+	const float scale = sampleLength * float(kArcLengthSampleCount);	//区間を[0,1]×[0,1]にしたときの傾きの係数
+	const float m0 = scale < 3.0f * speeds[sample] ? scale / speeds[sample] : 3.0f;
+	const float m1 = scale < 3.0f * speeds[sample + 1] ? scale / speeds[sample + 1] : 3.0f;
+	const float u = std::clamp((localDistance - table[sample]) / sampleLength, 0.0f, 1.0f);
+	const float u2 = u * u;
+	const float u3 = u2 * u;
+	const float fraction = (u3 - 2.0f * u2 + u) * m0 + (-2.0f * u3 + 3.0f * u2) + (u3 - u2) * m1;
+	return float(segment) + (float(sample) + fraction) / float(kArcLengthSampleCount);
+}
+
+Vector3 CatmullRomSpline::EvaluateAtDistance(float distance) const
+{
+	return Evaluate(GetParameterAtDistance(distance));
+}
+
+void CatmullRomSpline::EvaluateAtDistances(const float* distances, size_t count, Vector3* result) const
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		result[i] = Evaluate(GetParameterAtDistance(distances[i]));
+	}
+}
+
+Vector3 CatmullRomSpline::ClosestPoint(const Vector3& point, float* parameter) const
+{
+	assert(IsUpToDate());
+
+	// 区間までの距離の下限（境界の球とAABBまでの距離の大きい方）の2乗
+	const uint32_t segmentCount = GetSegmentCount();
+	std::vector<float> lowerBounds(segmentCount);
+	uint32_t nearest = 0;
+	for (uint32_t segment = 0; segment < segmentCount; ++segment)
+	{
+		const AABB& bounds = segmentAABBs_[segment];
+		const Sphere& sphere = segmentSpheres_[segment];
+		Vector3 outside = {
+			std::max({ bounds.min.x - point.x, 0.0f, point.x - bounds.max.x }),
+			std::max({ bounds.min.y - point.y, 0.0f, point.y - bounds.max.y }),
+			std::max({ bounds.min.z - point.z, 0.0f, point.z - bounds.max.z }) };
+		float sphereDistance = std::max(mathFunc_.Length(mathFunc_.Subtract(point, sphere.center)) - sphere.radius, 0.0f);
+		lowerBounds[segment] = std::max(mathFunc_.Dot(outside, outside), sphereDistance * sphereDistance);
+		if (lowerBounds[segment] < lowerBounds[nearest])
+		{
+			nearest = segment;
+		}
+	}
+
+	// 下限が最も小さい区間で最短を決めてから、下限がそれより近い区間だけを調べる
+	Vector3 best{};
+	float bestDistanceSq = FLT_MAX;
+	float bestParameter = 0.0f;
+	auto consider = [&](uint32_t segment)
+		{
+			float t = 0.0f;
+			Vector3 closest = mathFunc_.ClosestPoint(point, segments_[segment], &t);
+			Vector3 diff = mathFunc_.Subtract(closest, point);
+			float distanceSq = mathFunc_.Dot(diff, diff);
+			if (distanceSq < bestDistanceSq)
+			{
+				best = closest;
+				bestDistanceSq = distanceSq;
+				bestParameter = float(segment) + t;
+			}
+		};
+	consider(nearest);
+	for (uint32_t segment = 0; segment < segmentCount; ++segment)
+	{
+		if (segment != nearest && lowerBounds[segment] < bestDistanceSq)
+		{
+			consider(segment);
+		}
+	}
+	if (parameter)
+	{
+		*parameter = bestParameter;
+	}
+	return best;
+}
+
+bool CatmullRomSpline::IsCollision(const Sphere& sphere) const
+{
+	assert(IsUpToDate());
+	for (uint32_t segment = 0; segment < GetSegmentCount(); ++segment)
+	{
+		if (mathFunc_.IsCollision(segmentSpheres_[segment], sphere) && mathFunc_.IsCollision(segmentAABBs_[segment], sphere) && mathFunc_.IsCollision(segments_[segment], sphere))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool CatmullRomSpline::IsCollision(const AABB& aabb) const
+{
+	assert(IsUpToDate());
+	for (uint32_t segment = 0; segment < GetSegmentCount(); ++segment)
+	{
+		if (mathFunc_.IsCollision(segmentAABBs_[segment], aabb) && mathFunc_.IsCollision(segments_[segment], aabb))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+float CatmullRomSpline::GetLength() const
+{
+	assert(IsUpToDate());
+	return segmentStarts_.empty() ? 0.0f : segmentStarts_.back();
+}
+
+const CubicCurve& CatmullRomSpline::GetSegment(uint32_t index) const
+{
+	assert(IsUpToDate());
+	assert(index < segments_.size());
+	return segments_[index];
+}
+
+const AABB& CatmullRomSpline::GetSegmentAABB(uint32_t index) const
+{
+	assert(IsUpToDate());
+	assert(index < segmentAABBs_.size());
+	return segmentAABBs_[index];
+}
+
+const Sphere& CatmullRomSpline::GetSegmentSphere(uint32_t index) const
+{
+	assert(IsUpToDate());
+	assert(index < segmentSpheres_.size());
+	return segmentSpheres_[index];
+}
+
+Vector3 CatmullRomSpline::GetExtendedPoint(int64_t index) const
+{
+	const int64_t count = int64_t(controlPoints_.size());
+	if (isLoop_)
+	{
+		return controlPoints_[size_t((index % count + count) % count)];
+	}
+	if (index < 0)
+	{
+		return mathFunc_.Subtract(mathFunc_.Multiply(2.0f, controlPoints_[0]), controlPoints_[1]);
+	}
+	if (index >= count)
+	{
+		return mathFunc_.Subtract(mathFunc_.Multiply(2.0f, controlPoints_[count - 1]), controlPoints_[count - 2]);
+	}
+	return controlPoints_[size_t(index)];
+}
+
+void CatmullRomSpline::MarkDirty(uint32_t segment)
+{
+	if (!isSegmentDirty_[segment])
+	{
+		isSegmentDirty_[segment] = 1;
+		dirtySegments_.push_back(segment);
+	}
+}
+
+void CatmullRomSpline::BuildSegment(uint32_t segment)
+{
+	const float kMinKnotInterval = 1.0e-4f;	//重なった制御点でノットの間隔が0にならないようにする下限
+	const Vector3 p0 = GetExtendedPoint(int64_t(segment) - 1);
+	const Vector3 p1 = GetExtendedPoint(int64_t(segment));
+	const Vector3 p2 = GetExtendedPoint(int64_t(segment) + 1);
+	const Vector3 p3 = GetExtendedPoint(int64_t(segment) + 2);
+
+	// ノットの間隔 |ΔP|^α（一様はα=0、求心はα=0.5）
+	const float alpha = type_ == CatmullRomType::Centripetal ? 0.5f : 0.0f;
+	float d1 = std::pow(mathFunc_.Length(mathFunc_.Subtract(p2, p1)), alpha);
+	d1 = d1 < kMinKnotInterval ? 1.0f : d1;
+	float d0 = std::pow(mathFunc_.Length(mathFunc_.Subtract(p1, p0)), alpha);
+	d0 = d0 < kMinKnotInterval ? d1 : d0;
+	float d2 = std::pow(mathFunc_.Length(mathFunc_.Subtract(p3, p2)), alpha);
+	d2 = d2 < kMinKnotInterval ? d1 : d2;
+
+	// 不均一なノットでのp1・p2の接線を、区間を[0,1]にしたときの大きさ（×d1）で求める
+	Vector3 m1 = mathFunc_.Add(mathFunc_.Subtract(mathFunc_.Multiply(1.0f / d0, mathFunc_.Subtract(p1, p0)), mathFunc_.Multiply(1.0f / (d0 + d1), mathFunc_.Subtract(p2, p0))), mathFunc_.Multiply(1.0f / d1, mathFunc_.Subtract(p2, p1)));
+	Vector3 m2 = mathFunc_.Add(mathFunc_.Subtract(mathFunc_.Multiply(1.0f / d1, mathFunc_.Subtract(p2, p1)), mathFunc_.Multiply(1.0f / (d1 + d2), mathFunc_.Subtract(p3, p1))), mathFunc_.Multiply(1.0f / d2, mathFunc_.Subtract(p3, p2)));
+	m1 = mathFunc_.Multiply(d1, m1);
+	m2 = mathFunc_.Multiply(d1, m2);
+
+	// エルミート曲線の、tの各次数の項
+	CubicCurve& curve = segments_[segment];
+	curve.coefficients[0] = p1;
+	curve.coefficients[1] = m1;
+	curve.coefficients[2] = {
+		-3.0f * p1.x + 3.0f * p2.x - 2.0f * m1.x - m2.x,
+		-3.0f * p1.y + 3.0f * p2.y - 2.0f * m1.y - m2.y,
+		-3.0f * p1.z + 3.0f * p2.z - 2.0f * m1.z - m2.z };
+	curve.coefficients[3] = {
+		2.0f * p1.x - 2.0f * p2.x + m1.x + m2.x,
+		2.0f * p1.y - 2.0f * p2.y + m1.y + m2.y,
+		2.0f * p1.z - 2.0f * p2.z + m1.z + m2.z };
+
+	segmentAABBs_[segment] = mathFunc_.MakeAABB(curve);
+	segmentSpheres_[segment] = mathFunc_.MakeSphere(curve);
+
+	// 弧長表。分割した各区間の長さを3点のガウス・ルジャンドル求積で求め、各点の速さも持っておく
+	const float kGaussNode = 0.7745966692f;		// sqrt(3/5)
+	const float kGaussWeights[] = { 5.0f / 9.0f, 8.0f / 9.0f, 5.0f / 9.0f };
+	const float kGaussNodes[] = { -kGaussNode, 0.0f, kGaussNode };
+	const float step = 1.0f / float(kArcLengthSampleCount);
+	const size_t tableBegin = size_t(segment) * (kArcLengthSampleCount + 1);
+	float* table = arcLengths_.data() + tableBegin;
+	float* speeds = speeds_.data() + tableBegin;
+	table[0] = 0.0f;
+	for (uint32_t sample = 0; sample < kArcLengthSampleCount; ++sample)
+	{
+		const float middle = (float(sample) + 0.5f) * step;
+		float length = 0.0f;
+		for (uint32_t node = 0; node < 3; ++node)
+		{
+			length += kGaussWeights[node] * mathFunc_.Length(mathFunc_.EvaluateDerivative(curve, middle + 0.5f * step * kGaussNodes[node]));
+		}
+		table[sample + 1] = table[sample] + 0.5f * step * length;
+	}
+	for (uint32_t sample = 0; sample <= kArcLengthSampleCount; ++sample)
+	{
+		speeds[sample] = mathFunc_.Length(mathFunc_.EvaluateDerivative(curve, float(sample) * step));
+	}
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include "AABB.h"
+#include "CubicCurve.h"
+#include "MathFunction.h"
+#include "Sphereh.h"
+#include "Vector3.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//Catmull-Romスプラインのノット（区間の長さ）の取り方
+enum class CatmullRomType : uint32_t
+{
+	Uniform,		//!<一様（区間の長さは全て1。MakeCatmullRomCurveと同じ）
+	Centripetal,	//!<求心（制御点間の距離の平方根。尖りや自己交差が出にくい）
+};
+
+/// <summary>
+/// 任意の数の制御点を通るCatmull-Romスプライン。区間ごとの係数・境界・弧長表を持ち、距離で一定速度に点を求められる。
+/// 制御点を動かすと影響する区間（前後2区間まで）だけをUpdateで作り直す
+/// </summary>
+class CatmullRomSpline
+{
+public:
+	/// <summary>
+	/// 制御点を全て差し替える（全ての区間をUpdateで作り直す）
+	/// </summary>
+	/// <param name="points"></param>
+	/// <param name="count">2以上</param>
+	/// <param name="type"></param>
+	/// <param name="isLoop">最後の制御点から最初の制御点へも繋ぐ</param>
+	void SetControlPoints(const Vector3* points, uint32_t count, CatmullRomType type = CatmullRomType::Centripetal, bool isLoop = false);
+	/// <summary>
+	/// 制御点を1つ動かす（影響する区間をUpdateで作り直す）
+	/// </summary>
+	/// <param name="index"></param>
+	/// <param name="point"></param>
+	void SetControlPoint(uint32_t index, const Vector3& point);
+	/// <summary>
+	/// 変更のあった区間の係数・境界・弧長表を作り直す（問い合わせの前に呼ぶ）
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// スプライン上の点
+	/// </summary>
+	/// <param name="parameter">[0, 区間数]。整数部が区間の番号、小数部が区間内のt</param>
+	/// <returns></returns>
+	Vector3 Evaluate(float parameter) const;
+	/// <summary>
+	/// 始点からの距離に対応するパラメータ（弧長表を二分探索し、表の間は両端の速さを傾きにしたエルミート補間で求める）
+	/// </summary>
+	/// <param name="distance">ループなら全長で折り返し、そうでなければ[0, 全長]に収める</param>
+	/// <returns></returns>
+	float GetParameterAtDistance(float distance) const;
+	/// <summary>
+	/// 始点からの距離にある点
+	/// </summary>
+	/// <param name="distance"></param>
+	/// <returns></returns>
+	Vector3 EvaluateAtDistance(float distance) const;
+	/// <summary>
+	/// 始点からの距離にある点（一括）
+	/// </summary>
+	/// <param name="distances"></param>
+	/// <param name="count"></param>
+	/// <param name="result">要素数分の出力先</param>
+	void EvaluateAtDistances(const float* distances, size_t count, Vector3* result) const;
+
+	/// <summary>
+	/// スプライン上の最近接点（区間の境界までの距離が今の最短より遠い区間は調べない）
+	/// </summary>
+	/// <param name="point"></param>
+	/// <param name="parameter">指定すると最近接点のパラメータ（Evaluateと同じ）を受け取る</param>
+	/// <returns></returns>
+	Vector3 ClosestPoint(const Vector3& point, float* parameter = nullptr) const;
+	/// <summary>
+	/// スプラインと球の衝突判定（区間の境界で除外してから区間ごとに判定する）
+	/// </summary>
+	/// <param name="sphere"></param>
+	/// <returns></returns>
+	bool IsCollision(const Sphere& sphere) const;
+	/// <summary>
+	/// スプラインとAABBの衝突判定（区間の境界で除外してから区間ごとに判定する）
+	/// </summary>
+	/// <param name="aabb"></param>
+	/// <returns></returns>
+	bool IsCollision(const AABB& aabb) const;
+
+	/// <summary>
+	/// 全長
+	/// </summary>
+	/// <returns></returns>
+	float GetLength() const;
+	/// <summary>
+	/// 区間の数（ループなら制御点の数、そうでなければ1つ少ない）
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetSegmentCount() const { return uint32_t(segments_.size()); }
+	/// <summary>
+	/// 区間の曲線（制御点index→index+1）
+	/// </summary>
+	/// <param name="index"></param>
+	/// <returns></returns>
+	const CubicCurve& GetSegment(uint32_t index) const;
+	/// <summary>
+	/// 区間を囲むAABB
+	/// </summary>
+	/// <param name="index"></param>
+	/// <returns></returns>
+	const AABB& GetSegmentAABB(uint32_t index) const;
+	/// <summary>
+	/// 区間を囲む球
+	/// </summary>
+	/// <param name="index"></param>
+	/// <returns></returns>
+	const Sphere& GetSegmentSphere(uint32_t index) const;
+	/// <summary>
+	/// 制御点の数
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetControlPointCount() const { return uint32_t(controlPoints_.size()); }
+	/// <summary>
+	/// 制御点
+	/// </summary>
+	/// <param name="index"></param>
+	/// <returns></returns>
+	const Vector3& GetControlPoint(uint32_t index) const { return controlPoints_[index]; }
+
+private:
+	static const uint32_t kArcLengthSampleCount = 16;	//区間ごとの弧長表の分割数
+
+	/// <summary>
+	/// 区間の計算に使う制御点。端の外側は端の点で折り返した点、ループなら反対側の点
+	/// </summary>
+	/// <param name="index">-1から制御点の数まで</param>
+	/// <returns></returns>
+	Vector3 GetExtendedPoint(int64_t index) const;
+	/// <summary>
+	/// 区間を作り直す必要があるとして記録する
+	/// </summary>
+	/// <param name="segment"></param>
+	void MarkDirty(uint32_t segment);
+	/// <summary>
+	/// 区間の係数・境界・弧長表を求める
+	/// </summary>
+	/// <param name="segment"></param>
+	void BuildSegment(uint32_t segment);
+	/// <summary>
+	/// 全て作り直し済みか
+	/// </summary>
+	/// <returns></returns>
+	bool IsUpToDate() const { return dirtySegments_.empty(); }
+
+	std::vector<Vector3> controlPoints_;		//制御点
+	std::vector<CubicCurve> segments_;			//区間ごとの曲線
+	std::vector<AABB> segmentAABBs_;			//区間を囲むAABB
+	std::vector<Sphere> segmentSpheres_;		//区間を囲む球
+	std::vector<float> arcLengths_;				//区間ごとの弧長表（区間の始点からの長さ。区間ごとにkArcLengthSampleCount+1個）
+	std::vector<float> speeds_;					//弧長表の各点での速さ（|曲線の微分|。arcLengths_と同じ並び）
+	std::vector<float> segmentStarts_;			//区間の始点までの長さ（区間の数+1個。最後は全長）
+	std::vector<uint32_t> dirtySegments_;		//作り直しが必要な区間
+	std::vector<uint8_t> isSegmentDirty_;		//区間ごとの、dirtySegments_に入っているか
+	CatmullRomType type_ = CatmullRomType::Centripetal;	//ノットの取り方
+	bool isLoop_ = false;						//閉じた曲線か
+	mutable MathFunction mathFunc_;				//区間の係数・弧長の計算と衝突判定
+};
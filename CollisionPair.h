@@ -0,0 +1,9 @@
+#pragma once
+#include <cstdint>
+
+//衝突している2つの物体の番号（first < second）
+struct CollisionPair final
+{
+	uint32_t first;		//!<小さい方の番号
+	uint32_t second;	//!<大きい方の番号
+};
@@ -0,0 +1,216 @@
+#include "CollisionWorld.h"
+#include <algorithm>
+#include <assert.h>
+
+namespace
+{
+	bool LessPair(const CollisionPair& a, const CollisionPair& b)
+	{
+		return a.first != b.first ? a.first < b.first : a.second < b.second;
+	}
+}
+
+void CollisionWorld::SetSpheres(const Sphere* spheres, uint32_t count)
+{
+	assert(count <= kIndexMask);
+	spheres_.assign(spheres, spheres + count);
+	isDynamicBVHDirty_ = true;
+}
+
+void CollisionWorld::SetAABBs(const AABB* aabbs, uint32_t count)
+{
+	assert(count <= kIndexMask);
+	aabbs_.assign(aabbs, aabbs + count);
+	isDynamicBVHDirty_ = true;
+}
+
+void CollisionWorld::SetPlanes(const Plane* planes, uint32_t count)
+{
+	assert(count <= kIndexMask);
+	planes_.assign(planes, planes + count);
+}
+
+void CollisionWorld::SetTriangles(const Triangle* triangles, uint32_t count)
+{
+	assert(count <= kIndexMask);
+	triangles_.assign(triangles, triangles + count);
+	std::vector<AABB> bounds(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const Vector3* vertices = triangles_[i].vertices;
+		bounds[i].min = { std::min({ vertices[0].x, vertices[1].x, vertices[2].x }), std::min({ vertices[0].y, vertices[1].y, vertices[2].y }), std::min({ vertices[0].z, vertices[1].z, vertices[2].z }) };
+		bounds[i].max = { std::max({ vertices[0].x, vertices[1].x, vertices[2].x }), std::max({ vertices[0].y, vertices[1].y, vertices[2].y }), std::max({ vertices[0].z, vertices[1].z, vertices[2].z }) };
+	}
+	triangleBVH_.Build(bounds.data(), count);
+}
+
+void CollisionWorld::SetSphere(uint32_t index, const Sphere& sphere)
+{
+	assert(index < spheres_.size());
+	spheres_[index] = sphere;
+}
+
+void CollisionWorld::SetAABB(uint32_t index, const AABB& aabb)
+{
+	assert(index < aabbs_.size());
+	aabbs_[index] = aabb;
+}
+
+void CollisionWorld::Update(JobSystem& jobSystem)
+{
+	const uint32_t dynamicCount = GetSphereCount() + GetAABBCount();
+
+	// 動く物体のAABBを求めて木に反映する（数が変わったときだけ作り直し、普段は形を変えずに境界だけ更新）
+	if (isDynamicBVHDirty_)
+	{
+		std::vector<AABB> bounds(dynamicCount);
+		jobSystem.ParallelFor(dynamicCount, kObjectGrainSize, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					bounds[i] = GetDynamicBounds(i);
+				}
+			});
+		dynamicBVH_.Build(bounds.data(), dynamicCount);
+		isDynamicBVHDirty_ = false;
+	}
+	else
+	{
+		jobSystem.ParallelFor(dynamicCount, kObjectGrainSize, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					dynamicBVH_.SetAABB(i, GetDynamicBounds(i));
+				}
+			});
+		dynamicBVH_.Refit(jobSystem);
+	}
+
+	// ジョブは、動く物体同士の探索を分けたもの → 動く物体kObjectGrainSize個ごとの地形との判定、の順に並べる
+	dynamicBVH_.SplitOverlapPairs(kOverlapTaskCount, overlapTasks_);
+	const uint32_t overlapJobCount = uint32_t(overlapTasks_.size());
+	const uint32_t staticJobCount = (planes_.empty() && triangles_.empty()) ? 0 : (dynamicCount + kObjectGrainSize - 1) / kObjectGrainSize;
+	const uint32_t jobCount = overlapJobCount + staticJobCount;
+	jobPairs_.resize(jobCount);
+
+	jobSystem.ParallelFor(jobCount, 1, [&](uint32_t begin, uint32_t end)
+		{
+			std::vector<uint32_t> candidates;
+			for (uint32_t job = begin; job < end; ++job)
+			{
+				std::vector<CollisionPair>& pairs = jobPairs_[job];
+				pairs.clear();
+				if (job < overlapJobCount)
+				{
+					dynamicBVH_.QueryOverlapPairs(overlapTasks_[job], [&](uint32_t a, uint32_t b)
+						{
+							if (IsDynamicCollision(a, b))
+							{
+								pairs.push_back(CollisionPair{ GetDynamicId(a), GetDynamicId(b) });
+							}
+						});
+					continue;
+				}
+
+				// 動く物体と地形。地形の番号は動く物体より必ず大きいので、組のfirstは動く物体になる
+				const uint32_t objectBegin = (job - overlapJobCount) * kObjectGrainSize;
+				const uint32_t objectEnd = std::min(dynamicCount, objectBegin + kObjectGrainSize);
+				for (uint32_t i = objectBegin; i < objectEnd; ++i)
+				{
+					const uint32_t id = GetDynamicId(i);
+					const bool isSphere = GetColliderType(id) == ColliderType::Sphere;
+					const uint32_t index = GetColliderIndex(id);
+					for (uint32_t p = 0; p < planes_.size(); ++p)
+					{
+						if (isSphere ? mathFunc_.IsCollision(spheres_[index], planes_[p]) : mathFunc_.IsCollision(aabbs_[index], planes_[p]))
+						{
+							pairs.push_back(CollisionPair{ id, MakeColliderId(ColliderType::Plane, p) });
+						}
+					}
+					if (triangles_.empty())
+					{
+						continue;
+					}
+					triangleBVH_.QueryAABB(dynamicBVH_.GetAABB(i), candidates);
+					for (uint32_t t : candidates)
+					{
+						if (isSphere ? mathFunc_.IsCollision(triangles_[t], spheres_[index]) : mathFunc_.IsCollision(triangles_[t], aabbs_[index]))
+						{
+							pairs.push_back(CollisionPair{ id, MakeColliderId(ColliderType::Triangle, t) });
+						}
+					}
+				}
+			}
+		});
+
+	// ジョブごとの結果を1つの配列に並列で集める
+	std::vector<uint32_t> offsets(size_t(jobCount) + 1, 0);
+	for (uint32_t job = 0; job < jobCount; ++job)
+	{
+		offsets[job + 1] = offsets[job] + uint32_t(jobPairs_[job].size());
+	}
+	pairs_.resize(offsets[jobCount]);
+	jobSystem.ParallelFor(jobCount, 1, [&](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t job = begin; job < end; ++job)
+			{
+				std::copy(jobPairs_[job].begin(), jobPairs_[job].end(), pairs_.begin() + offsets[job]);
+			}
+		});
+
+	SortPairs(jobSystem);
+}
+
+AABB CollisionWorld::GetDynamicBounds(uint32_t index) const
+{
+	const uint32_t sphereCount = GetSphereCount();
+	return index < sphereCount ? mathFunc_.MakeAABB(spheres_[index]) : aabbs_[index - sphereCount];
+}
+
+uint32_t CollisionWorld::GetDynamicId(uint32_t index) const
+{
+	const uint32_t sphereCount = GetSphereCount();
+	return index < sphereCount ? MakeColliderId(ColliderType::Sphere, index) : MakeColliderId(ColliderType::AABB, index - sphereCount);
+}
+
+bool CollisionWorld::IsDynamicCollision(uint32_t a, uint32_t b) const
+{
+	// a < b なので、球とAABBの組なら必ずaが球
+	const uint32_t sphereCount = GetSphereCount();
+	if (b < sphereCount)
+	{
+		return mathFunc_.IsCollision(spheres_[a], spheres_[b]);
+	}
+	if (a < sphereCount)
+	{
+		return mathFunc_.IsCollision(aabbs_[b - sphereCount], spheres_[a]);
+	}
+	return true; // AABB同士はBVHの判定がそのまま詳細判定
+}
+
+void CollisionWorld::SortPairs(JobSystem& jobSystem)
+{
+	const uint32_t count = uint32_t(pairs_.size());
+	jobSystem.ParallelFor(count, kSortGrainSize, [&](uint32_t begin, uint32_t end)
+		{
+			std::sort(pairs_.begin() + begin, pairs_.begin() + end, LessPair);
+		});
+
+	// 並んだ区間を2つずつ併合する。区間の切り方は数だけで決まる
+	sortBuffer_.resize(count);
+	for (uint32_t width = kSortGrainSize; width < count; width *= 2)
+	{
+		const uint32_t mergeCount = uint32_t((uint64_t(count) + width * 2 - 1) / (uint64_t(width) * 2));
+		jobSystem.ParallelFor(mergeCount, 1, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t merge = begin; merge < end; ++merge)
+				{
+					const uint32_t first = merge * width * 2;
+					const uint32_t middle = std::min(count, first + width);
+					const uint32_t last = std::min(count, middle + width);
+					std::merge(pairs_.begin() + first, pairs_.begin() + middle, pairs_.begin() + middle, pairs_.begin() + last, sortBuffer_.begin() + first, LessPair);
+				}
+			});
+		pairs_.swap(sortBuffer_);
+	}
+}
@@ -0,0 +1,163 @@
+#pragma once
+#include "AABB.h"
+#include "BVH.h"
+#include "CollisionPair.h"
+#include "JobSystem.h"
+#include "MathFunction.h"
+#include "Plane.h"
+#include "Sphereh.h"
+#include "Triangle.h"
+#include <cstdint>
+#include <vector>
+
+//コライダーの種類（番号の上位2ビット。組はこの順に並ぶ）
+enum class ColliderType : uint32_t
+{
+	Sphere,		//!<球（動く）
+	AABB,		//!<AABB（動く）
+	Plane,		//!<平面（動かない）
+	Triangle,	//!<三角形（動かない）
+};
+
+/// <summary>
+/// 球・AABB（動く物体）と平面・三角形（動かない地形）を持ち、衝突している組をJobSystemで並列に求める。
+/// 広域判定は動く物体のBVHの自己重なりと、三角形のBVHへの問い合わせ。結果はスレッド数によらず同じ並びになる
+/// </summary>
+class CollisionWorld
+{
+public:
+	/// <summary>
+	/// 球を全て差し替える（次のUpdateでBVHを作り直す）
+	/// </summary>
+	/// <param name="spheres"></param>
+	/// <param name="count"></param>
+	void SetSpheres(const Sphere* spheres, uint32_t count);
+	/// <summary>
+	/// AABBを全て差し替える（次のUpdateでBVHを作り直す）
+	/// </summary>
+	/// <param name="aabbs"></param>
+	/// <param name="count"></param>
+	void SetAABBs(const AABB* aabbs, uint32_t count);
+	/// <summary>
+	/// 平面を全て差し替える
+	/// </summary>
+	/// <param name="planes"></param>
+	/// <param name="count"></param>
+	void SetPlanes(const Plane* planes, uint32_t count);
+	/// <summary>
+	/// 三角形を全て差し替え、三角形のBVHを作る
+	/// </summary>
+	/// <param name="triangles"></param>
+	/// <param name="count"></param>
+	void SetTriangles(const Triangle* triangles, uint32_t count);
+
+	/// <summary>
+	/// 球を動かす。Updateで木の境界を更新する（形は変えない）
+	/// </summary>
+	/// <param name="index"></param>
+	/// <param name="sphere"></param>
+	void SetSphere(uint32_t index, const Sphere& sphere);
+	/// <summary>
+	/// AABBを動かす。Updateで木の境界を更新する（形は変えない）
+	/// </summary>
+	/// <param name="index"></param>
+	/// <param name="aabb"></param>
+	void SetAABB(uint32_t index, const AABB& aabb);
+
+	/// <summary>
+	/// 衝突している組を求める（動かない物体同士は判定しない）
+	/// </summary>
+	/// <param name="jobSystem"></param>
+	void Update(JobSystem& jobSystem);
+	/// <summary>
+	/// 衝突している組（コライダー番号の昇順。firstは種類の順で前の方）
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<CollisionPair>& GetPairs() const { return pairs_; }
+
+	/// <summary>
+	/// コライダー番号を作る
+	/// </summary>
+	/// <param name="type"></param>
+	/// <param name="index">種類ごとの配列の添え字</param>
+	/// <returns></returns>
+	static uint32_t MakeColliderId(ColliderType type, uint32_t index) { return uint32_t(type) << kTypeShift | index; }
+	/// <summary>
+	/// コライダー番号の種類
+	/// </summary>
+	/// <param name="id"></param>
+	/// <returns></returns>
+	static ColliderType GetColliderType(uint32_t id) { return ColliderType(id >> kTypeShift); }
+	/// <summary>
+	/// コライダー番号の、種類ごとの配列の添え字
+	/// </summary>
+	/// <param name="id"></param>
+	/// <returns></returns>
+	static uint32_t GetColliderIndex(uint32_t id) { return id & kIndexMask; }
+
+	/// <summary>
+	/// 球の数
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetSphereCount() const { return uint32_t(spheres_.size()); }
+	/// <summary>
+	/// AABBの数
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetAABBCount() const { return uint32_t(aabbs_.size()); }
+	/// <summary>
+	/// 平面の数
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetPlaneCount() const { return uint32_t(planes_.size()); }
+	/// <summary>
+	/// 三角形の数
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetTriangleCount() const { return uint32_t(triangles_.size()); }
+
+private:
+	static const uint32_t kTypeShift = 30;							//番号のうち種類を入れるビット位置
+	static const uint32_t kIndexMask = (1u << kTypeShift) - 1;		//番号のうち添え字の部分
+	static const uint32_t kObjectGrainSize = 256;					//物体ごとの処理を1ジョブにまとめる数
+	static const uint32_t kOverlapTaskCount = 1024;					//動く物体同士の探索を分ける数（スレッド数によらず固定）
+	static const uint32_t kSortGrainSize = 4096;					//並列ソートで1ジョブが最初に並べる数
+
+	/// <summary>
+	/// 動く物体（球→AABBの順）のAABB
+	/// </summary>
+	/// <param name="index">動く物体の番号</param>
+	/// <returns></returns>
+	AABB GetDynamicBounds(uint32_t index) const;
+	/// <summary>
+	/// 動く物体のコライダー番号（動く物体の番号の順とコライダー番号の順は同じ）
+	/// </summary>
+	/// <param name="index"></param>
+	/// <returns></returns>
+	uint32_t GetDynamicId(uint32_t index) const;
+	/// <summary>
+	/// 動く物体同士の詳細判定（BVHでAABBが重なっている組）
+	/// </summary>
+	/// <param name="a"></param>
+	/// <param name="b"></param>
+	/// <returns></returns>
+	bool IsDynamicCollision(uint32_t a, uint32_t b) const;
+	/// <summary>
+	/// 組をコライダー番号の昇順に並列で並べる（区間ごとにソートしてから2つずつ併合する）
+	/// </summary>
+	/// <param name="jobSystem"></param>
+	void SortPairs(JobSystem& jobSystem);
+
+	std::vector<Sphere> spheres_;						//球
+	std::vector<AABB> aabbs_;							//AABB
+	std::vector<Plane> planes_;							//平面
+	std::vector<Triangle> triangles_;					//三角形
+	BVH dynamicBVH_;									//動く物体のBVH
+	BVH triangleBVH_;									//三角形のBVH
+	bool isDynamicBVHDirty_ = true;						//動く物体が差し替えられ、作り直しが必要
+	std::vector<BVH::OverlapTask> overlapTasks_;		//動く物体同士の探索を分けたもの
+	std::vector<std::vector<CollisionPair>> jobPairs_;	//ジョブごとに見つけた組
+	std::vector<CollisionPair> pairs_;					//衝突している組
+	std::vector<CollisionPair> sortBuffer_;				//併合の作業領域
+	mutable MathFunction mathFunc_;						//形状同士の衝突判定とAABBの作成
+};
@@ -0,0 +1,12 @@
+#pragma once
+#include "Vector3.h"
+#include <cstdint>
+
+//接触情報（衝突の解消に使う。法線は1つ目の形状から2つ目の形状へ向かう）
+struct ContactManifold final
+{
+	Vector3 normal;			//!< 2つ目の形状を押し出す向きの単位ベクトル
+	float depth;			//!< めり込みの深さ（接しているだけなら0）
+	Vector3 points[4];		//!< 接触点
+	uint32_t pointCount;	//!< 接触点の数
+};
@@ -0,0 +1,8 @@
+#pragma once
+#include "Vector3.h"
+
+//3次以下の多項式曲線 p(t) = c0 + c1 t + c2 t^2 + c3 t^3（tは[0, 1]。係数は制御点から1回だけ求める）
+struct CubicCurve final
+{
+	Vector3 coefficients[4];	//!< t^0, t^1, t^2, t^3 の係数
+};
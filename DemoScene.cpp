@@ -0,0 +1,50 @@
+#include "DemoScene.h"
+
+void DemoScene::Initialize(int windowWidth, int windowHeight)
+{
+	// 透視投影行列を作成
+	projectionMatrix_ = mathFunc_.MakePerspectiveFovMatrix(0.45f, float(windowWidth) / float(windowHeight), 0.1f, 100.0f);
+	// ビューポート変換行列を作成
+	viewportMatrix_ = mathFunc_.MakeViewportMatrix(0.0f, 0.0f, float(windowWidth), float(windowHeight), 0.0f, 1.0f);
+}
+
+void DemoScene::Update(int dragDeltaX, int dragDeltaY, int wheel)
+{
+	// マウスドラッグによる回転制御
+	rotate_.y += dragDeltaX * 0.01f; // 水平方向の回転
+	rotate_.x += dragDeltaY * 0.01f; // 垂直方向の回転
+
+	// マウスホイールで前後移動
+	if (wheel != 0)
+	{
+		cameraTranslate_.z += wheel * 0.01f; // ホイールの回転方向に応じて前後移動
+	}
+
+	//各種行列の計算
+	Matrix4x4 worldMatrix = mathFunc_.MakeAffineMatrix({ 1.0f,1.0f,1.0f }, rotate_, translate_);
+	Matrix4x4 cameraMatrix = mathFunc_.MakeAffineMatrix({ 1.0f,1.0f,1.0f }, cameraRotate_, cameraTranslate_);
+	Matrix4x4 viewWorldMatrix = mathFunc_.InverseAffine(worldMatrix);
+	Matrix4x4 viewCameraMatrix = mathFunc_.InverseRigid(cameraMatrix);	//カメラは拡縮しないので剛体変換
+	//ビュー座標変換行列を作成
+	Matrix4x4 viewProjectionMatrix = mathFunc_.Multiply(viewWorldMatrix, mathFunc_.Multiply(viewCameraMatrix, projectionMatrix_));
+	//スクリーン変換はフレームごとに1回だけ作り、各描画で使い回す
+	screenTransform_ = mathFunc_.MakeScreenTransform(viewProjectionMatrix, viewportMatrix_);
+}
+
+void DemoScene::Draw()
+{
+	// Gridを描画
+	mathFunc_.DrawGrid(screenTransform_);
+
+	// コントロールポイントを球で描画
+	for (int i = 0; i < kControlPointCount; ++i)
+	{
+		Sphere controlSphere = { controllPoints_[i], 0.01f };
+		mathFunc_.DrawSphere(controlSphere, screenTransform_, 0x000000FF);
+	}
+
+	// Catmull-Rom曲線を描画
+	mathFunc_.DrawCatmullRom(controllPoints_[0], controllPoints_[1], controllPoints_[2], controllPoints_[3], screenTransform_, 0xFFFFFFFF);
+	mathFunc_.DrawCatmullRom(controllPoints_[3], controllPoints_[1], controllPoints_[0], controllPoints_[2], screenTransform_, 0xFFFFFFFF);
+	mathFunc_.DrawCatmullRom(controllPoints_[1], controllPoints_[2], controllPoints_[3], controllPoints_[2], screenTransform_, 0xFFFFFFFF);
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "MathFunction.h"
+
+/// <summary>
+/// 課題のシーン（更新と描画）。ウィンドウや入力には依存しないので、ヘッドレスでも動かせる
+/// </summary>
+class DemoScene
+{
+public:
+	static const int kControlPointCount = 4;	//コントロールポイントの数
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="windowWidth">画面の幅</param>
+	/// <param name="windowHeight">画面の高さ</param>
+	void Initialize(int windowWidth, int windowHeight);
+	/// <summary>
+	/// 更新
+	/// </summary>
+	/// <param name="dragDeltaX">マウスドラッグの移動量X</param>
+	/// <param name="dragDeltaY">マウスドラッグの移動量Y</param>
+	/// <param name="wheel">マウスホイールの回転量</param>
+	void Update(int dragDeltaX, int dragDeltaY, int wheel);
+	/// <summary>
+	/// 描画（mathFuncに設定された描画先に出力する）
+	/// </summary>
+	void Draw();
+
+	/// <summary>
+	/// 描画に使うMathFunction
+	/// </summary>
+	/// <returns></returns>
+	MathFunction& GetMathFunction() { return mathFunc_; }
+	/// <summary>
+	/// コントロールポイント（ImGuiなどから編集する）
+	/// </summary>
+	/// <returns></returns>
+	Vector3* GetControlPoints() { return controllPoints_; }
+
+private:
+	MathFunction mathFunc_;
+
+	Vector3 rotate_ = {};
+	Vector3 translate_ = {};
+	Vector3 cameraTranslate_ = { 0.0f, 1.9f, -6.49f };
+	Vector3 cameraRotate_ = { 0.26f, 0.0f, 0.0f };
+
+	// コントロールポイント
+	Vector3 controllPoints_[kControlPointCount] =
+	{
+		{ -0.8f, 0.58f, 1.0f },
+		{ 1.76f, 1.0f, -0.3f },
+		{ 0.94f, -0.7f, 2.3f },
+		{ -0.53f, -0.26f, -0.15f }
+	};
+
+	Matrix4x4 projectionMatrix_ = {};		//透視投影行列
+	Matrix4x4 viewportMatrix_ = {};			//ビューポート変換行列
+	ScreenTransform screenTransform_ = {};	//フレームごとのスクリーン変換
+};
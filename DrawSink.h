@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// 描画命令の出力先（Noviceやメモリ上のバッファなどに差し替えられる）
+/// </summary>
+class DrawSink
+{
+public:
+	virtual ~DrawSink() = default;
+
+	/// <summary>
+	/// 線を描画
+	/// </summary>
+	/// <param name="x1">始点X（スクリーン座標）</param>
+	/// <param name="y1">始点Y（スクリーン座標）</param>
+	/// <param name="x2">終点X（スクリーン座標）</param>
+	/// <param name="y2">終点Y（スクリーン座標）</param>
+	/// <param name="color">色</param>
+	virtual void DrawLine(int x1, int y1, int x2, int y2, uint32_t color) = 0;
+	/// <summary>
+	/// 三角形をワイヤーフレームで描画
+	/// </summary>
+	/// <param name="x1"></param>
+	/// <param name="y1"></param>
+	/// <param name="x2"></param>
+	/// <param name="y2"></param>
+	/// <param name="x3"></param>
+	/// <param name="y3"></param>
+	/// <param name="color">色</param>
+	virtual void DrawTriangle(int x1, int y1, int x2, int y2, int x3, int y3, uint32_t color) = 0;
+};
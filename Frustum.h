@@ -0,0 +1,8 @@
+#pragma once
+#include "Plane.h"
+
+//視錐台（法線は内向きで、Dot(normal, p) - distance >= 0 の側が内側）
+struct Frustum final
+{
+	Plane planes[6];	//!< 左・右・下・上・近・遠の平面
+};
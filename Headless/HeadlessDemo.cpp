@@ -0,0 +1,40 @@
+#include "DemoScene.h"
+#include "LineCommandBuffer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// main.cppと同じフレームループをウィンドウなしで回す
+// マウスドラッグは一定量の回転で代用し、描画はLineCommandBufferに記録する
+
+namespace
+{
+	const int kWindowWidth = 1280;
+	const int kWindowHeight = 720;
+}
+
+int main(int argc, char** argv)
+{
+	const int frameCount = argc > 1 ? std::atoi(argv[1]) : 600;	// 実行するフレーム数
+
+	LineCommandBuffer buffer(kWindowWidth, kWindowHeight);
+	DemoScene scene;
+	scene.Initialize(kWindowWidth, kWindowHeight);
+	scene.GetMathFunction().SetDrawSink(&buffer);
+
+	size_t totalLines = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		buffer.Clear();
+		scene.Update(2, 1, 0);
+		scene.Draw();
+		totalLines += buffer.GetLines().size();
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	double us = double(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+	std::printf("frames %d  %.2f us/frame  %.1f lines/frame (submitted %zu in last frame)\n",
+		frameCount, us / (frameCount > 0 ? frameCount : 1), double(totalLines) / (frameCount > 0 ? frameCount : 1), buffer.GetSubmittedCount());
+	return 0;
+}
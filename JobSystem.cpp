@@ -0,0 +1,134 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <assert.h>
+
+JobSystem::JobSystem(uint32_t threadCount)
+{
+	if (threadCount == 0)
+	{
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+	queues_ = std::make_unique<JobQueue[]>(threadCount);
+	threads_.reserve(threadCount - 1);
+	for (uint32_t i = 1; i < threadCount; ++i)
+	{
+		threads_.emplace_back(&JobSystem::WorkerMain, this, i);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isQuit_ = true;
+	}
+	wake_.notify_all();
+	for (std::thread& thread : threads_)
+	{
+		thread.join();
+	}
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& function)
+{
+	assert(grainSize > 0);
+	assert(!function_ && "ParallelForの入れ子は不可");
+	const uint32_t jobCount = (count + grainSize - 1) / grainSize;
+	if (threads_.empty() || jobCount <= 1)
+	{
+		// 1スレッドでも区間の区切り方は同じにする
+		for (uint32_t begin = 0; begin < count; begin += grainSize)
+		{
+			function(begin, std::min(count, begin + grainSize));
+		}
+		return;
+	}
+
+	function_ = &function;
+	count_ = count;
+	grainSize_ = grainSize;
+	remainingJobs_.store(jobCount);
+
+	// 連続した区間をまとめて各スレッドに配る（近い区間は同じスレッドで処理されやすく、偏った分は盗まれる）
+	const uint32_t threadCount = GetThreadCount();
+	for (uint32_t thread = 0; thread < threadCount; ++thread)
+	{
+		std::lock_guard<std::mutex> lock(queues_[thread].mutex);
+		for (uint32_t job = uint32_t(uint64_t(jobCount) * thread / threadCount); job < uint64_t(jobCount) * (thread + 1) / threadCount; ++job)
+		{
+			queues_[thread].jobs.push_back(job);
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		++generation_;
+	}
+	wake_.notify_all();
+
+	RunJobs(0);
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	done_.wait(lock, [this] { return remainingJobs_.load() == 0; });
+	function_ = nullptr;
+}
+
+void JobSystem::WorkerMain(uint32_t threadIndex)
+{
+	uint64_t seenGeneration = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			wake_.wait(lock, [&] { return isQuit_ || generation_ != seenGeneration; });
+			if (isQuit_)
+			{
+				return;
+			}
+			seenGeneration = generation_;
+		}
+		RunJobs(threadIndex);
+	}
+}
+
+void JobSystem::RunJobs(uint32_t threadIndex)
+{
+	uint32_t job = 0;
+	while (PopJob(threadIndex, &job))
+	{
+		uint32_t begin = job * grainSize_;
+		(*function_)(begin, std::min(count_, begin + grainSize_));
+		if (remainingJobs_.fetch_sub(1) == 1)
+		{
+			// 待っている呼び出し元が判定と待機の間で通知を取りこぼさないよう、ロックしてから通知する
+			std::lock_guard<std::mutex> lock(mutex_);
+			done_.notify_all();
+		}
+	}
+}
+
+bool JobSystem::PopJob(uint32_t threadIndex, uint32_t* job)
+{
+	{
+		JobQueue& own = queues_[threadIndex];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.jobs.empty())
+		{
+			*job = own.jobs.front();
+			own.jobs.pop_front();
+			return true;
+		}
+	}
+	const uint32_t threadCount = GetThreadCount();
+	for (uint32_t i = 1; i < threadCount; ++i)
+	{
+		JobQueue& victim = queues_[(threadIndex + i) % threadCount];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty())
+		{
+			*job = victim.jobs.back();
+			victim.jobs.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
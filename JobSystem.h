@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// ワークスティーリングのスレッドプール。ParallelForの範囲をgrainSizeごとのジョブに分けて各スレッドの列に配り、
+/// 自分の列が空になったスレッドは他のスレッドの列の後ろから盗む。呼び出し元のスレッドもジョブを処理する
+/// </summary>
+class JobSystem
+{
+public:
+	/// <summary>
+	/// ワーカースレッドを起動する
+	/// </summary>
+	/// <param name="threadCount">呼び出し元を含むスレッド数。0ならハードウェアのスレッド数</param>
+	explicit JobSystem(uint32_t threadCount = 0);
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/// <summary>
+	/// [0, count)を先頭からgrainSizeずつ区切り、各区間でfunctionを並列に呼ぶ。全て終わるまで戻らない。
+	/// 区切り方はスレッド数によらないので、区間ごとに結果を書けば並びは決定的になる（入れ子の呼び出しは不可）
+	/// </summary>
+	/// <param name="count"></param>
+	/// <param name="grainSize"></param>
+	/// <param name="function">void(区間の先頭, 区間の終端)</param>
+	void ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& function);
+
+	/// <summary>
+	/// 呼び出し元を含むスレッド数
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetThreadCount() const { return uint32_t(threads_.size()) + 1; }
+
+private:
+	//スレッドごとのジョブの列（ジョブは区間の番号）
+	struct JobQueue final
+	{
+		std::mutex mutex;				//!<列の保護
+		std::deque<uint32_t> jobs;		//!<区間の番号（持ち主は前から、盗む側は後ろから取る）
+	};
+
+	/// <summary>
+	/// ワーカースレッドの本体
+	/// </summary>
+	/// <param name="threadIndex"></param>
+	void WorkerMain(uint32_t threadIndex);
+	/// <summary>
+	/// 自分の列と他のスレッドの列からジョブが無くなるまで処理する
+	/// </summary>
+	/// <param name="threadIndex"></param>
+	void RunJobs(uint32_t threadIndex);
+	/// <summary>
+	/// 自分の列の前から、空なら他のスレッドの列の後ろからジョブを取る
+	/// </summary>
+	/// <param name="threadIndex"></param>
+	/// <param name="job"></param>
+	/// <returns>取れたらtrue</returns>
+	bool PopJob(uint32_t threadIndex, uint32_t* job);
+
+	std::vector<std::thread> threads_;				//ワーカースレッド（スレッド番号1以降）
+	std::unique_ptr<JobQueue[]> queues_;			//スレッドごとのジョブの列（0は呼び出し元）
+	std::mutex mutex_;								//起床・完了通知の保護
+	std::condition_variable wake_;					//ジョブが配られたことの通知
+	std::condition_variable done_;					//全てのジョブが終わったことの通知
+	uint64_t generation_ = 0;						//ParallelForを呼んだ回数（起床の判定）
+	bool isQuit_ = false;							//終了要求
+	std::atomic<uint32_t> remainingJobs_{ 0 };		//終わっていないジョブの数
+	const std::function<void(uint32_t, uint32_t)>* function_ = nullptr;	//実行中の処理
+	uint32_t count_ = 0;							//実行中の範囲の大きさ
+	uint32_t grainSize_ = 1;						//実行中の区間の大きさ
+};
@@ -0,0 +1,73 @@
+#include "LineCommandBuffer.h"
+#include <algorithm>
+#include <cmath>
+
+LineCommandBuffer::LineCommandBuffer(int width, int height)
+	: width_(width), height_(height)
+{
+}
+
+void LineCommandBuffer::DrawLine(int x1, int y1, int x2, int y2, uint32_t color)
+{
+	++submittedCount_;
+
+	// Liang-Barsky法で画面の矩形 [0, width-1] x [0, height-1] にクリップする
+	const float dx = float(x2) - float(x1);
+	const float dy = float(y2) - float(y1);
+	const float p[4] = { -dx, dx, -dy, dy };
+	const float q[4] = { float(x1), float(width_ - 1) - float(x1), float(y1), float(height_ - 1) - float(y1) };
+	float tEnter = 0.0f;
+	float tExit = 1.0f;
+	for (int i = 0; i < 4; ++i)
+	{
+		if (p[i] == 0.0f)
+		{
+			// 境界と平行で外側にある
+			if (q[i] < 0.0f)
+			{
+				return;
+			}
+			continue;
+		}
+		float t = q[i] / p[i];
+		if (p[i] < 0.0f)
+		{
+			tEnter = std::max(tEnter, t);
+		}
+		else
+		{
+			tExit = std::min(tExit, t);
+		}
+	}
+	if (tEnter > tExit)
+	{
+		return;
+	}
+
+	LineCommand line{ x1, y1, x2, y2, color };
+	if (tEnter > 0.0f)
+	{
+		line.x1 = x1 + int(std::lround(tEnter * dx));
+		line.y1 = y1 + int(std::lround(tEnter * dy));
+	}
+	if (tExit < 1.0f)
+	{
+		line.x2 = x1 + int(std::lround(tExit * dx));
+		line.y2 = y1 + int(std::lround(tExit * dy));
+	}
+	lines_.push_back(line);
+}
+
+void LineCommandBuffer::DrawTriangle(int x1, int y1, int x2, int y2, int x3, int y3, uint32_t color)
+{
+	// ワイヤーフレームなので3本の線として記録する
+	DrawLine(x1, y1, x2, y2, color);
+	DrawLine(x2, y2, x3, y3, color);
+	DrawLine(x3, y3, x1, y1, color);
+}
+
+void LineCommandBuffer::Clear()
+{
+	lines_.clear();
+	submittedCount_ = 0;
+}
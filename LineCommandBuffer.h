@@ -0,0 +1,53 @@
+#pragma once
+#include "DrawSink.h"
+#include <cstddef>
+#include <vector>
+
+//記録された線（スクリーン座標）
+struct LineCommand final
+{
+	int x1;				//!< 始点X
+	int y1;				//!< 始点Y
+	int x2;				//!< 終点X
+	int y2;				//!< 終点Y
+	uint32_t color;		//!< 色
+};
+
+/// <summary>
+/// 描画命令をメモリ上に記録する出力先（GPUなしで描画結果の検証や計測ができる）
+/// 線は画面の矩形でクリップしてから記録し、画面外の線は記録しない
+/// </summary>
+class LineCommandBuffer : public DrawSink
+{
+public:
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="width">画面の幅</param>
+	/// <param name="height">画面の高さ</param>
+	LineCommandBuffer(int width, int height);
+
+	void DrawLine(int x1, int y1, int x2, int y2, uint32_t color) override;
+	void DrawTriangle(int x1, int y1, int x2, int y2, int x3, int y3, uint32_t color) override;
+
+	/// <summary>
+	/// 記録を消去（確保したメモリは再利用する）
+	/// </summary>
+	void Clear();
+	/// <summary>
+	/// 記録された線
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<LineCommand>& GetLines() const { return lines_; }
+	/// <summary>
+	/// 受け取った線の数（クリップで捨てたものも含む）
+	/// </summary>
+	/// <returns></returns>
+	size_t GetSubmittedCount() const { return submittedCount_; }
+
+private:
+	int width_;							//画面の幅
+	int height_;						//画面の高さ
+	std::vector<LineCommand> lines_;	//クリップ済みの線
+	size_t submittedCount_ = 0;			//受け取った線の数
+};
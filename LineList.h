@@ -0,0 +1,12 @@
+#pragma once
+#include "Vector3.h"
+#include <cstdint>
+
+//添え字つきの線のリスト（頂点は線の間で共有し、各線は両端の頂点番号で表す。読み取り専用）
+struct LineList final
+{
+	const Vector3* vertices;	//!< 頂点の配列
+	uint32_t vertexCount;		//!< 頂点数
+	const uint32_t* indices;	//!< 線ごとの始点・終点の頂点番号（2個ずつ）
+	uint32_t lineCount;			//!< 線の数
+};
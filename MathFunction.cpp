@@ -1,5 +1,6 @@
 #include "MathFunction.h"
-#include "Novice.h"
+#include "SimdConfig.h"
+#include "SphereLattice.h"
 
 Vector3 MathFunction::Add(const Vector3& v1, const Vector3& v2)
 {
@@ -74,7 +75,7 @@ Vector3 MathFunction::Project(const Vector3& v1, const Vector3& v2)
 	return Multiply(Dot(v1, v2) / powf(Length(v2), 2), v2);
 }
 
-Vector3 MathFunction::ClosestPoint(const Vector3& point, const Segment& segment)
+Vector3 MathFunction::ClosestPoint(const Vector3& point, const Segment& segment, float* t)
 {
 	// 線分の始点から終点へのベクトル
 	Vector3 segmentVec = segment.diff;
@@ -82,15 +83,90 @@ Vector3 MathFunction::ClosestPoint(const Vector3& point, const Segment& segment)
 	// 線分の始点からpointへのベクトル
 	Vector3 pointToOrigin = Subtract(point, segment.origin);
 
-	// 線分の始点からpointへのベクトルを、線分の方向ベクトルに投影し、線分上の点を求める
-	float t = Dot(pointToOrigin, segmentVec) / Dot(segmentVec, segmentVec);
+	// 線分の始点からpointへのベクトルを、線分の方向ベクトルに投影し、線分上に収める
+	float lengthSq = Dot(segmentVec, segmentVec);
+	float segmentT = lengthSq > 0.0f ? std::clamp(Dot(pointToOrigin, segmentVec) / lengthSq, 0.0f, 1.0f) : 0.0f;
+	if (t)
+	{
+		*t = segmentT;
+	}
 
 	// 線分上の最近接点
-	Vector3 closestPointOnSegment = Add(segment.origin, Multiply(t, segmentVec));
+	Vector3 closestPointOnSegment = Add(segment.origin, Multiply(segmentT, segmentVec));
 
 	return closestPointOnSegment;
 }
 
+Vector3 MathFunction::ClosestPoint(const Vector3& point, const Ray& ray, float* t)
+{
+	// 始点より後ろの点は始点が最も近い
+	float rayT = std::max(Dot(Subtract(point, ray.origin), ray.diff) / Dot(ray.diff, ray.diff), 0.0f);
+	if (t)
+	{
+		*t = rayT;
+	}
+	return Add(ray.origin, Multiply(rayT, ray.diff));
+}
+
+Vector3 MathFunction::ClosestPoint(const Vector3& point, const Line& line, float* t)
+{
+	float lineT = Dot(Subtract(point, line.origin), line.diff) / Dot(line.diff, line.diff);
+	if (t)
+	{
+		*t = lineT;
+	}
+	return Add(line.origin, Multiply(lineT, line.diff));
+}
+
+Vector3 MathFunction::ClosestPoint(const Vector3& point, const Triangle& triangle)
+{
+	// 頂点・辺・面のどの領域に点が入るかを、辺ベクトルとの内積だけで順に調べる
+	const Vector3& a = triangle.vertices[0];
+	const Vector3& b = triangle.vertices[1];
+	const Vector3& c = triangle.vertices[2];
+	Vector3 ab = Subtract(b, a);
+	Vector3 ac = Subtract(c, a);
+	Vector3 ap = Subtract(point, a);
+	float d1 = Dot(ab, ap);
+	float d2 = Dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f)
+	{
+		return a;
+	}
+	Vector3 bp = Subtract(point, b);
+	float d3 = Dot(ab, bp);
+	float d4 = Dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3)
+	{
+		return b;
+	}
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+	{
+		return Add(a, Multiply(d1 / (d1 - d3), ab));
+	}
+	Vector3 cp = Subtract(point, c);
+	float d5 = Dot(ab, cp);
+	float d6 = Dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6)
+	{
+		return c;
+	}
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+	{
+		return Add(a, Multiply(d2 / (d2 - d6), ac));
+	}
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+	{
+		return Add(b, Multiply((d4 - d3) / ((d4 - d3) + (d5 - d6)), Subtract(c, b)));
+	}
+	// 面の内側：重心座標で求める
+	float denominator = 1.0f / (va + vb + vc);
+	return Add(a, Add(Multiply(vb * denominator, ab), Multiply(vc * denominator, ac)));
+}
+
 Vector3 MathFunction::Perpendicular(const Vector3& vector)
 {
 	if (vector.x != 0.0f || vector.z != 0.0f)
@@ -116,6 +192,184 @@ Vector3 MathFunction::CatmullRom(const Vector3& p0, const Vector3& p1, const Vec
 	};
 }
 
+CubicCurve MathFunction::MakeBezierCurve(const Vector3& p0, const Vector3& p1, const Vector3& p2)
+{
+	// (1-t)^2 p0 + 2t(1-t) p1 + t^2 p2 を t について展開する
+	CubicCurve curve{};
+	curve.coefficients[0] = p0;
+	curve.coefficients[1] = Multiply(2.0f, Subtract(p1, p0));
+	curve.coefficients[2] = Add(Subtract(p0, Multiply(2.0f, p1)), p2);
+	curve.coefficients[3] = { 0.0f, 0.0f, 0.0f };
+	return curve;
+}
+
+CubicCurve MathFunction::MakeBezierCurve(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3)
+{
+	CubicCurve curve{};
+	curve.coefficients[0] = p0;
+	curve.coefficients[1] = Multiply(3.0f, Subtract(p1, p0));
+	curve.coefficients[2] = Multiply(3.0f, Add(Subtract(p0, Multiply(2.0f, p1)), p2));
+	curve.coefficients[3] = Add(Subtract(Multiply(3.0f, Subtract(p1, p2)), p0), p3);
+	return curve;
+}
+
+CubicCurve MathFunction::MakeCatmullRomCurve(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3)
+{
+	// CatmullRom関数の式の、tの各次数の項
+	CubicCurve curve{};
+	curve.coefficients[0] = p1;
+	curve.coefficients[1] = Multiply(0.5f, Subtract(p2, p0));
+	curve.coefficients[2] = {
+		0.5f * (2.0f * p0.x - 5.0f * p1.x + 4.0f * p2.x - p3.x),
+		0.5f * (2.0f * p0.y - 5.0f * p1.y + 4.0f * p2.y - p3.y),
+		0.5f * (2.0f * p0.z - 5.0f * p1.z + 4.0f * p2.z - p3.z) };
+	curve.coefficients[3] = {
+		0.5f * (-p0.x + 3.0f * p1.x - 3.0f * p2.x + p3.x),
+		0.5f * (-p0.y + 3.0f * p1.y - 3.0f * p2.y + p3.y),
+		0.5f * (-p0.z + 3.0f * p1.z - 3.0f * p2.z + p3.z) };
+	return curve;
+}
+
+Vector3 MathFunction::Evaluate(const CubicCurve& curve, float t)
+{
+	const Vector3* c = curve.coefficients;
+	return {
+		c[0].x + t * (c[1].x + t * (c[2].x + t * c[3].x)),
+		c[0].y + t * (c[1].y + t * (c[2].y + t * c[3].y)),
+		c[0].z + t * (c[1].z + t * (c[2].z + t * c[3].z)) };
+}
+
+Vector3 MathFunction::EvaluateDerivative(const CubicCurve& curve, float t)
+{
+	const Vector3* c = curve.coefficients;
+	return {
+		c[1].x + t * (2.0f * c[2].x + t * 3.0f * c[3].x),
+		c[1].y + t * (2.0f * c[2].y + t * 3.0f * c[3].y),
+		c[1].z + t * (2.0f * c[2].z + t * 3.0f * c[3].z) };
+}
+
+void MathFunction::EvaluateUniform(const CubicCurve& curve, size_t count, Vector3* result)
+{
+	assert(count >= 2);
+	const Vector3* c = curve.coefficients;
+	const float h = 1.0f / float(count - 1);
+	const float h2 = h * h;
+	const float h3 = h2 * h;
+
+	// 1階・2階・3階の差分。3次式なので3階の差分は一定
+	Vector3 point = c[0];
+	Vector3 delta1 = Add(Add(Multiply(h, c[1]), Multiply(h2, c[2])), Multiply(h3, c[3]));
+	Vector3 delta2 = Add(Multiply(2.0f * h2, c[2]), Multiply(6.0f * h3, c[3]));
+	Vector3 delta3 = Multiply(6.0f * h3, c[3]);
+	for (size_t i = 0; i + 1 < count; ++i)
+	{
+		result[i] = point;
+		point = Add(point, delta1);
+		delta1 = Add(delta1, delta2);
+		delta2 = Add(delta2, delta3);
+	}
+	// 加算の誤差がたまる終点は、t=1の値（係数の和）で置き換える
+	result[count - 1] = Add(Add(c[0], c[1]), Add(c[2], c[3]));
+}
+
+CubicCurve MathFunction::MakeSubCurve(const CubicCurve& curve, float t0, float t1)
+{
+	// C(t0 + h s) をsについて展開する
+	const Vector3* c = curve.coefficients;
+	const float h = t1 - t0;
+	CubicCurve result{};
+	result.coefficients[0] = Evaluate(curve, t0);
+	result.coefficients[1] = Multiply(h, EvaluateDerivative(curve, t0));
+	result.coefficients[2] = Multiply(h * h, Add(c[2], Multiply(3.0f * t0, c[3])));
+	result.coefficients[3] = Multiply(h * h * h, c[3]);
+	return result;
+}
+
+Vector3 MathFunction::ClosestPoint(const Vector3& point, const CubicCurve& curve, float* t)
+{
+	const uint32_t kSampleCount = 16;			//極小を探す区間の数
+	const uint32_t kRefineIterations = 8;		//区間内で詰める回数の上限
+	const float kStep = 1.0f / float(kSampleCount);
+	const Vector3* c = curve.coefficients;
+
+	// 距離の2乗の微分の半分 f(t) = (C(t) - p)・C'(t)。負から正に変わるところが極小
+	auto slopeAt = [&](float sampleT)
+		{
+			return Dot(Subtract(Evaluate(curve, sampleT), point), EvaluateDerivative(curve, sampleT));
+		};
+	auto distanceSqAt = [&](float sampleT)
+		{
+			Vector3 diff = Subtract(Evaluate(curve, sampleT), point);
+			return Dot(diff, diff);
+		};
+
+	float slopes[kSampleCount + 1];
+	for (uint32_t i = 0; i <= kSampleCount; ++i)
+	{
+		slopes[i] = slopeAt(float(i) * kStep);
+	}
+
+	// 端点は常に候補
+	float bestT = 0.0f;
+	float bestDistanceSq = FLT_MAX;
+	auto consider = [&](float sampleT)
+		{
+			float distanceSq = distanceSqAt(sampleT);
+			if (distanceSq < bestDistanceSq)
+			{
+				bestT = sampleT;
+				bestDistanceSq = distanceSq;
+			}
+		};
+	consider(0.0f);
+	consider(1.0f);
+
+	// 符号が変わる区間ごとに、二分法で守ったニュートン法で f(t) = 0 を解く
+	for (uint32_t i = 0; i < kSampleCount; ++i)
+	{
+		if (!(slopes[i] <= 0.0f && slopes[i + 1] > 0.0f))
+		{
+			continue;
+		}
+		float lower = float(i) * kStep;
+		float upper = float(i + 1) * kStep;
+		float sampleT = 0.5f * (lower + upper);
+		for (uint32_t iteration = 0; iteration < kRefineIterations; ++iteration)
+		{
+			Vector3 diff = Subtract(Evaluate(curve, sampleT), point);
+			Vector3 first = EvaluateDerivative(curve, sampleT);
+			Vector3 second = Add(Multiply(2.0f, c[2]), Multiply(6.0f * sampleT, c[3]));
+			float slope = Dot(diff, first);
+			if (slope < 0.0f)
+			{
+				lower = sampleT;
+			}
+			else
+			{
+				upper = sampleT;
+			}
+			float curvature = Dot(first, first) + Dot(diff, second);
+			float nextT = curvature > 0.0f ? sampleT - slope / curvature : lower - 1.0f;
+			if (!(lower < nextT && nextT < upper))
+			{
+				nextT = 0.5f * (lower + upper);
+			}
+			if (std::fabs(nextT - sampleT) <= 1.0e-6f)
+			{
+				sampleT = nextT;
+				break;
+			}
+			sampleT = nextT;
+		}
+		consider(sampleT);
+	}
+	if (t)
+	{
+		*t = bestT;
+	}
+	return Evaluate(curve, bestT);
+}
+
 Matrix4x4 MathFunction::Add(const Matrix4x4& m1, const Matrix4x4& m2)
 {
 	Matrix4x4 result;
@@ -144,21 +398,54 @@ Matrix4x4 MathFunction::Subtract(const Matrix4x4& m1, const Matrix4x4& m2)
 
 Matrix4x4 MathFunction::Multiply(const Matrix4x4& m1, const Matrix4x4& m2)
 {
-	Matrix4x4 result{};
+	Matrix4x4 result;
+#if defined(MATH_SIMD_AVX2)
+	// 2行ずつ処理する。各128bitレーンで m1 の i行目・i+1行目の k番目を m2 の k行目に掛けて足し合わせる
+	const __m256 row0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[0]));
+	const __m256 row1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[1]));
+	const __m256 row2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[2]));
+	const __m256 row3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[3]));
+	for (int i = 0; i < 4; i += 2)
+	{
+		__m256 a = _mm256_loadu_ps(m1.m[i]);
+		__m256 sum = _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), row0);
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), row1));
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), row2));
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), row3));
+		_mm256_storeu_ps(result.m[i], sum);
+	}
+#elif defined(MATH_SIMD_SSE2)
+	// 結果の i行目 = Σk m1[i][k] * (m2 の k行目)
+	const __m128 row0 = _mm_loadu_ps(m2.m[0]);
+	const __m128 row1 = _mm_loadu_ps(m2.m[1]);
+	const __m128 row2 = _mm_loadu_ps(m2.m[2]);
+	const __m128 row3 = _mm_loadu_ps(m2.m[3]);
+	for (int i = 0; i < 4; i++)
+	{
+		__m128 sum = _mm_mul_ps(_mm_set1_ps(m1.m[i][0]), row0);
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m1.m[i][1]), row1));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m1.m[i][2]), row2));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m1.m[i][3]), row3));
+		_mm_storeu_ps(result.m[i], sum);
+	}
+#else
 	for (int i = 0; i < 4; i++)
 	{
 		for (int j = 0; j < 4; j++)
 		{
+			float sum = 0.0f;
 			for (int k = 0; k < 4; k++)
 			{
-				result.m[i][j] += m1.m[i][k] * m2.m[k][j];
+				sum += m1.m[i][k] * m2.m[k][j];
 			}
+			result.m[i][j] = sum;
 		}
 	}
+#endif
 	return result;
 }
 
-Matrix4x4 MathFunction::Inverse(const Matrix4x4& matrix)
+Matrix4x4 MathFunction::Inverse(const Matrix4x4& matrix, bool* isInvertible)
 {
 	Matrix4x4 result{};
 
@@ -171,6 +458,12 @@ Matrix4x4 MathFunction::Inverse(const Matrix4x4& matrix)
 		matrix.m[0][3] * (matrix.m[1][0] * matrix.m[2][1] * matrix.m[3][2] + matrix.m[1][1] * matrix.m[2][2] * matrix.m[3][0] + matrix.m[1][2] * matrix.m[2][0] * matrix.m[3][1] -
 			matrix.m[1][2] * matrix.m[2][1] * matrix.m[3][0] - matrix.m[1][1] * matrix.m[2][0] * matrix.m[3][2] - matrix.m[1][0] * matrix.m[2][2] * matrix.m[3][1]);
 
+	// 行列式が0（または非有限）なら逆行列は存在しない
+	if (!IsInvertibleDeterminant(det, isInvertible))
+	{
+		return MakeIdentity();
+	}
+
 	result.m[0][0] = (matrix.m[1][1] * matrix.m[2][2] * matrix.m[3][3] + matrix.m[1][2] * matrix.m[2][3] * matrix.m[3][1] + matrix.m[1][3] * matrix.m[2][1] * matrix.m[3][2] -
 		matrix.m[1][3] * matrix.m[2][2] * matrix.m[3][1] - matrix.m[1][2] * matrix.m[2][1] * matrix.m[3][3] - matrix.m[1][1] * matrix.m[2][3] * matrix.m[3][2]) /
 		det;
@@ -226,6 +519,82 @@ Matrix4x4 MathFunction::Inverse(const Matrix4x4& matrix)
 	return result;
 }
 
+Matrix4x4 MathFunction::InverseAffine(const Matrix4x4& matrix, bool* isInvertible)
+{
+	assert(matrix.m[0][3] == 0.0f && matrix.m[1][3] == 0.0f && matrix.m[2][3] == 0.0f && matrix.m[3][3] == 1.0f);
+	const float(&m)[4][4] = matrix.m;
+
+	// 3x3部分の余因子（1行目の余因子は行列式にも使う）
+	float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+	float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+	float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+	float det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+	if (!IsInvertibleDeterminant(det, isInvertible))
+	{
+		return MakeIdentity();
+	}
+	float invDet = 1.0f / det;
+
+	// 3x3部分の逆行列 = 余因子行列の転置 / 行列式
+	Matrix4x4 result{};
+	result.m[0][0] = c00 * invDet;
+	result.m[1][0] = c01 * invDet;
+	result.m[2][0] = c02 * invDet;
+	result.m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * invDet;
+	result.m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * invDet;
+	result.m[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * invDet;
+	result.m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * invDet;
+	result.m[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * invDet;
+	result.m[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * invDet;
+
+	// 平行移動 = -t * (3x3部分の逆行列)
+	for (int j = 0; j < 3; j++)
+	{
+		result.m[3][j] = -(m[3][0] * result.m[0][j] + m[3][1] * result.m[1][j] + m[3][2] * result.m[2][j]);
+	}
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+Matrix4x4 MathFunction::InverseRigid(const Matrix4x4& matrix)
+{
+	assert(matrix.m[0][3] == 0.0f && matrix.m[1][3] == 0.0f && matrix.m[2][3] == 0.0f && matrix.m[3][3] == 1.0f);
+	const float(&m)[4][4] = matrix.m;
+
+	// 回転部分は直交行列なので、逆行列は転置
+	Matrix4x4 result{};
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			result.m[i][j] = m[j][i];
+		}
+	}
+
+	// 平行移動 = -t * 回転の転置
+	for (int j = 0; j < 3; j++)
+	{
+		result.m[3][j] = -(m[3][0] * m[j][0] + m[3][1] * m[j][1] + m[3][2] * m[j][2]);
+	}
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+bool MathFunction::IsInvertibleDeterminant(float det, bool* isInvertible)
+{
+	// 0・非正規化数・NaN・無限大は逆数が意味を持たないので特異として扱う
+	bool invertible = std::isfinite(det) && std::fabs(det) >= FLT_MIN;
+	if (isInvertible)
+	{
+		*isInvertible = invertible;
+	}
+	else
+	{
+		assert(invertible);
+	}
+	return invertible;
+}
+
 Matrix4x4 MathFunction::Transpose(const Matrix4x4& m)
 {
 	Matrix4x4 result{};
@@ -272,11 +641,13 @@ Matrix4x4 MathFunction::MakeScaleMatrix(const Vector3& scale)
 Matrix4x4 MathFunction::MakeRotateXMatrix(float radian)
 {
 	Matrix4x4 result{};
+	float cos = std::cos(radian);
+	float sin = std::sin(radian);
 	result.m[0][0] = 1.0f;
-	result.m[1][1] = std::cos(radian);
-	result.m[1][2] = std::sin(radian);
-	result.m[2][1] = -std::sin(radian);
-	result.m[2][2] = std::cos(radian);
+	result.m[1][1] = cos;
+	result.m[1][2] = sin;
+	result.m[2][1] = -sin;
+	result.m[2][2] = cos;
 	result.m[3][3] = 1.0f;
 	return result;
 }
@@ -284,11 +655,13 @@ Matrix4x4 MathFunction::MakeRotateXMatrix(float radian)
 Matrix4x4 MathFunction::MakeRotateYMatrix(float radian)
 {
 	Matrix4x4 result{};
-	result.m[0][0] = std::cos(radian);
-	result.m[0][2] = -std::sin(radian);
+	float cos = std::cos(radian);
+	float sin = std::sin(radian);
+	result.m[0][0] = cos;
+	result.m[0][2] = -sin;
 	result.m[1][1] = 1.0f;
-	result.m[2][0] = std::sin(radian);
-	result.m[2][2] = std::cos(radian);
+	result.m[2][0] = sin;
+	result.m[2][2] = cos;
 	result.m[3][3] = 1.0f;
 	return result;
 }
@@ -296,10 +669,12 @@ Matrix4x4 MathFunction::MakeRotateYMatrix(float radian)
 Matrix4x4 MathFunction::MakeRotateZMatrix(float radian)
 {
 	Matrix4x4 result{};
-	result.m[0][0] = std::cos(radian);
-	result.m[0][1] = std::sin(radian);
-	result.m[1][0] = -std::sin(radian);
-	result.m[1][1] = std::cos(radian);
+	float cos = std::cos(radian);
+	float sin = std::sin(radian);
+	result.m[0][0] = cos;
+	result.m[0][1] = sin;
+	result.m[1][0] = -sin;
+	result.m[1][1] = cos;
 	result.m[2][2] = 1.0f;
 	result.m[3][3] = 1.0f;
 	return result;
@@ -323,15 +698,41 @@ Matrix4x4 MathFunction::MakeTranslateMatrix(const Vector3& translate)
 
 Matrix4x4 MathFunction::MakeAffineMatrix(const Vector3& scale, const Vector3& radian, const Vector3& translate)
 {
-	Matrix4x4 scaleMatrix = MakeScaleMatrix(scale);
-	Matrix4x4 rotateXMatrix = MakeRotateXMatrix(radian.x);
-	Matrix4x4 rotateYMatrix = MakeRotateYMatrix(radian.y);
-	Matrix4x4 rotateZMatrix = MakeRotateZMatrix(radian.z);
-	Matrix4x4 translateMatrix = MakeTranslateMatrix(translate);
+	// S * Rx * Ry * Rz * T を展開した式で直接求める（sin/cosは各軸1回ずつ）
+	float cx = std::cos(radian.x), sx = std::sin(radian.x);
+	float cy = std::cos(radian.y), sy = std::sin(radian.y);
+	float cz = std::cos(radian.z), sz = std::sin(radian.z);
+
+	Matrix4x4 result;
+	result.m[0][0] = scale.x * (cy * cz);
+	result.m[0][1] = scale.x * (cy * sz);
+	result.m[0][2] = scale.x * (-sy);
+	result.m[0][3] = 0.0f;
 
-	return Multiply(Multiply(Multiply(scaleMatrix, rotateXMatrix), rotateYMatrix), Multiply(rotateZMatrix, translateMatrix));
+	result.m[1][0] = scale.y * (sx * sy * cz - cx * sz);
+	result.m[1][1] = scale.y * (sx * sy * sz + cx * cz);
+	result.m[1][2] = scale.y * (sx * cy);
+	result.m[1][3] = 0.0f;
 
-	//return Multiply(MakeScaleMatrix(scale), Multiply(Multiply(MakeRotateXMatrix(radian.x), Multiply(MakeRotateYMatrix(radian.y), MakeRotateZMatrix(radian.z))), MakeTranslateMatrix(translate)));
+	result.m[2][0] = scale.z * (cx * sy * cz + sx * sz);
+	result.m[2][1] = scale.z * (cx * sy * sz - sx * cz);
+	result.m[2][2] = scale.z * (cx * cy);
+	result.m[2][3] = 0.0f;
+
+	result.m[3][0] = translate.x;
+	result.m[3][1] = translate.y;
+	result.m[3][2] = translate.z;
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+void MathFunction::MakeAffineMatrix(const ConstVector3Span& scale, const ConstVector3Span& radian, const ConstVector3Span& translate, Matrix4x4* result)
+{
+	assert(scale.count == radian.count && scale.count == translate.count);
+	for (size_t i = 0; i < scale.count; ++i)
+	{
+		result[i] = MakeAffineMatrix({ scale.x[i], scale.y[i], scale.z[i] }, { radian.x[i], radian.y[i], radian.z[i] }, { translate.x[i], translate.y[i], translate.z[i] });
+	}
 }
 
 Matrix4x4 MathFunction::MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip)
@@ -371,109 +772,141 @@ Matrix4x4 MathFunction::MakeViewportMatrix(float left, float top, float width, f
 	return result;
 }
 
-void MathFunction::DrawGrid(const Matrix4x4& ViewProjectionMatrix, const Matrix4x4& ViewportMatrix)
+void MathFunction::SetDrawSink(DrawSink* drawSink)
 {
-	//Grid用
-	const float	kGridHalfWidth = 2.0f;										//Gridの半分の幅
-	const uint32_t kSubdivision = 10;										//分割数
-	const float kGridEvery = (kGridHalfWidth * 2.0f) / float(kSubdivision);	//1つ分の長さ
-
-	//水平方向の線を描画
-	for (uint32_t xIndex = 0; xIndex <= kSubdivision; xIndex++)
-	{
-		//上の情報を使ってワールド座標系上の始点と終点を求める
-		//X軸上の座標
-		float posX = -kGridHalfWidth + kGridEvery * xIndex;
-
-		//始点と終点
-		Vector3 start = { posX, 0.0f, -kGridHalfWidth };
-		Vector3 end = { posX, 0.0f, kGridHalfWidth };
-		//// ワールド座標系 -> スクリーン座標系まで変換をかける
-		start = Transform(start, Multiply(ViewProjectionMatrix, ViewportMatrix));
-		end = Transform(end, Multiply(ViewProjectionMatrix, ViewportMatrix));
-
-		//左から右も同じように順々に引いていく
-		for (uint32_t zIndex = 0; zIndex <= kSubdivision; zIndex++)
-		{
-			//奥から手前が左右に代わるだけ
-			//上の情報を使ってワールド座標系上の始点と終点を求める
-			//Z軸上の座標
-			float posZ = -kGridHalfWidth + kGridEvery * zIndex;
+	drawSink_ = drawSink;
+}
 
-			//始点と終点
-			Vector3 startZ = { -kGridHalfWidth, 0.0f, posZ };
-			Vector3 endZ = { kGridHalfWidth, 0.0f, posZ };
-			//// ワールド座標系 -> スクリーン座標系まで変換をかける
-			startZ = Transform(startZ, Multiply(ViewProjectionMatrix, ViewportMatrix));
-			endZ = Transform(endZ, Multiply(ViewProjectionMatrix, ViewportMatrix));
+ScreenTransform MathFunction::MakeScreenTransform(const Matrix4x4& viewProjectionMatrix, const Matrix4x4& viewportMatrix)
+{
+	return ScreenTransform{ Multiply(viewProjectionMatrix, viewportMatrix), MakeFrustum(viewProjectionMatrix) };
+}
 
-			//変換した画像を使って表示。色は薄い灰色(0xAAAAAAFF)、原点は黒ぐらいがいいが、なんでもいい
-			Novice::DrawLine((int)start.x, (int)start.y, (int)end.x, (int)end.y, 0x6F6F6FFF);
-			Novice::DrawLine((int)startZ.x, (int)startZ.y, (int)endZ.x, (int)endZ.y, 0x6F6F6FFF);
-		}
+Frustum MathFunction::MakeFrustum(const Matrix4x4& viewProjectionMatrix)
+{
+	// 行ベクトルなので、クリップ座標の成分jは (x, y, z, 1) と行列のj列目の内積になる
+	// -w <= x <= w, -w <= y <= w, 0 <= z <= w の6つの不等式が、そのまま内向きの6平面になる
+	const int kAxis[6] = { 0, 0, 1, 1, 2, 2 };						//比べる成分（左・右・下・上・近・遠）
+	const float kSign[6] = { 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f };	//成分の符号
+	const float kWScale[6] = { 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 1.0f };	//近平面は 0 <= z なのでwを足さない
+	const float (*m)[4] = viewProjectionMatrix.m;
+
+	Frustum frustum{};
+	for (int i = 0; i < 6; ++i)
+	{
+		const int axis = kAxis[i];
+		Vector3 normal = {
+			kWScale[i] * m[0][3] + kSign[i] * m[0][axis],
+			kWScale[i] * m[1][3] + kSign[i] * m[1][axis],
+			kWScale[i] * m[2][3] + kSign[i] * m[2][axis] };
+		float constant = kWScale[i] * m[3][3] + kSign[i] * m[3][axis];
+		float length = Length(normal);
+		assert(length != 0.0f);
+		// normal・p + constant >= 0 を Dot(normal, p) - distance >= 0 の形にする
+		frustum.planes[i] = Plane{ Multiply(1.0f / length, normal), -constant / length };
 	}
+	return frustum;
 }
 
-void MathFunction::DrawSphere(const Sphere& sphere, const Matrix4x4& viewProjectionMatrix, const Matrix4x4& viewportMatrix, uint32_t color)
+Vector3 MathFunction::Transform(const Vector3& vector, const ScreenTransform& screenTransform)
 {
-	//球体用
-	const uint32_t kSubdivision = 20;										//分割数
-	const float kLatStep = (float)M_PI / kSubdivision;						//緯度のステップ
-	const float kLonStep = 2.0f * (float)M_PI / kSubdivision;				//経度のステップ
+	return Transform(vector, screenTransform.matrix);
+}
+
+void MathFunction::TransformPoints(const Vector3* points, size_t count, const ScreenTransform& screenTransform, Vector3* result)
+{
+	TransformPoints(points, count, screenTransform.matrix, result);
+}
 
-	// 緯度のループ
-	for (uint32_t latIndex = 0; latIndex < kSubdivision; ++latIndex)
+namespace
+{
+	//DrawGridの格子。頂点は外周だけで、線の両端は外周の頂点を共有する
+	struct GridLineList
 	{
-		float lat = -0.5f * (float)M_PI + latIndex * kLatStep;	//現在の緯度
+		static constexpr float kGridHalfWidth = 2.0f;								//Gridの半分の幅
+		static const uint32_t kSubdivision = 10;									//分割数
+		static const uint32_t kVertexCount = (kSubdivision + 1) * 2 + (kSubdivision - 1) * 2;	//手前と奥の辺 + 左右の辺の角以外
+		static const uint32_t kLineCount = (kSubdivision + 1) * 2;					//X方向とZ方向の線
 
-		//次の緯度
-		float nextLat = lat + kLatStep;
+		Vector3 vertices[kVertexCount];
+		uint32_t indices[kLineCount * 2];
 
-		//経度のループ
-		for (uint32_t lonIndex = 0; lonIndex < kSubdivision; ++lonIndex)
+		GridLineList()
 		{
-			//現在の経度
-			float lon = lonIndex * kLonStep;
-
-			//次の経度
-			float nextLon = lon + kLonStep;
-
-			// 球面座標の計算
-			Vector3 pointA
+			const float kGridEvery = (kGridHalfWidth * 2.0f) / float(kSubdivision);	//1つ分の長さ
+			const uint32_t kFar = kSubdivision + 1;				//奥の辺の最初の頂点番号
+			const uint32_t kLeft = kFar * 2;					//左の辺（角以外）の最初の頂点番号
+			const uint32_t kRight = kLeft + kSubdivision - 1;	//右の辺（角以外）の最初の頂点番号
+			for (uint32_t index = 0; index <= kSubdivision; ++index)
 			{
-				sphere.center.x + sphere.radius * cos(lat) * cos(lon),
-				sphere.center.y + sphere.radius * sin(lat),
-				sphere.center.z + sphere.radius * cos(lat) * sin(lon)
-			};
+				float pos = -kGridHalfWidth + kGridEvery * index;
+				vertices[index] = { pos, 0.0f, -kGridHalfWidth };
+				vertices[kFar + index] = { pos, 0.0f, kGridHalfWidth };
+				if (0 < index && index < kSubdivision)
+				{
+					vertices[kLeft + index - 1] = { -kGridHalfWidth, 0.0f, pos };
+					vertices[kRight + index - 1] = { kGridHalfWidth, 0.0f, pos };
+				}
+			}
 
-			Vector3 pointB
+			//奥から手前への線を左から順に、次に左から右への線を手前から順に（手前と奥の線は角を結ぶ）
+			uint32_t* index = indices;
+			for (uint32_t xIndex = 0; xIndex <= kSubdivision; ++xIndex)
 			{
-				sphere.center.x + sphere.radius * cos(nextLat) * cos(lon),
-				sphere.center.y + sphere.radius * sin(nextLat),
-				sphere.center.z + sphere.radius * cos(nextLat) * sin(lon)
-			};
-
-			Vector3 pointC
+				*index++ = xIndex;
+				*index++ = kFar + xIndex;
+			}
+			for (uint32_t zIndex = 0; zIndex <= kSubdivision; ++zIndex)
 			{
-				sphere.center.x + sphere.radius * cos(lat) * cos(nextLon),
-				sphere.center.y + sphere.radius * sin(lat),
-				sphere.center.z + sphere.radius * cos(lat) * sin(nextLon)
-			};
+				*index++ = zIndex == 0 ? 0 : zIndex == kSubdivision ? kFar : kLeft + zIndex - 1;
+				*index++ = zIndex == 0 ? kSubdivision : zIndex == kSubdivision ? kFar + kSubdivision : kRight + zIndex - 1;
+			}
+		}
+
+		LineList Get() const { return LineList{ vertices, kVertexCount, indices, kLineCount }; }
+	};
 
-			// スクリーン座標に変換
-			pointA = Transform(pointA, Multiply(viewProjectionMatrix, viewportMatrix));
-			pointB = Transform(pointB, Multiply(viewProjectionMatrix, viewportMatrix));
-			pointC = Transform(pointC, Multiply(viewProjectionMatrix, viewportMatrix));
+	//AABBの頂点番号（ビット0・1・2がそれぞれx・y・zのmax側）で表した12本の辺
+	const uint32_t kAABBLineIndices[24] = { 0, 1, 0, 2, 0, 4, 1, 3, 1, 5, 2, 3, 2, 6, 3, 7, 4, 5, 4, 6, 5, 7, 6, 7 };
+}
 
-			// 線分の描画
-			Novice::DrawLine((int)pointA.x, (int)pointA.y, (int)pointB.x, (int)pointB.y, color);
-			Novice::DrawLine((int)pointA.x, (int)pointA.y, (int)pointC.x, (int)pointC.y, color);
-		}
+void MathFunction::DrawGrid(const ScreenTransform& screenTransform)
+{
+	assert(drawSink_);
+	//Grid用の線は1回だけ作り、色は薄い灰色
+	static const GridLineList kGrid;
+	DrawLineList(kGrid.Get(), screenTransform.matrix, 0x6F6F6FFF);
+}
+
+void MathFunction::DrawSphere(const Sphere& sphere, const ScreenTransform& screenTransform, uint32_t color)
+{
+	assert(drawSink_);
+	if (IsCollision(screenTransform.frustum, sphere))
+	{
+		DrawSphereLines(sphere, screenTransform, color);
 	}
 }
 
-void MathFunction::DrawPlane(const Plane& plane, const Matrix4x4& viewProjectionMatrix, const Matrix4x4& viewportMatrix, uint32_t color)
+void MathFunction::DrawSphereLines(const Sphere& sphere, const ScreenTransform& screenTransform, uint32_t color)
 {
+	//球体用
+	const uint32_t kSubdivision = 20;										//分割数
+	const SphereLattice& lattice = SphereLattice::Get(kSubdivision);		//単位球の格子（sin/cosと線は計算済み）
+
+	// 拡縮・平行移動とスクリーン変換を1つの行列にまとめる
+	Matrix4x4 sphereMatrix = MakeScaleMatrix({ sphere.radius, sphere.radius, sphere.radius });
+	sphereMatrix.m[3][0] = sphere.center.x;
+	sphereMatrix.m[3][1] = sphere.center.y;
+	sphereMatrix.m[3][2] = sphere.center.z;
+	sphereMatrix = Multiply(sphereMatrix, screenTransform.matrix);
+
+	// 格子の頂点をまとめてスクリーン座標に変換し（各頂点1回だけ）、線を描画
+	DrawLineList(lattice.GetLineList(), sphereMatrix, color);
+}
+
+void MathFunction::DrawPlane(const Plane& plane, const ScreenTransform& screenTransform, uint32_t color)
+{
+	assert(drawSink_);
 	Vector3 center = Multiply(plane.distance, plane.normal);
 	Vector3 perpendiculars[4];
 	perpendiculars[0] = Normalize(Perpendicular(plane.normal));
@@ -481,35 +914,92 @@ void MathFunction::DrawPlane(const Plane& plane, const Matrix4x4& viewProjection
 	perpendiculars[2] = Cross(plane.normal, perpendiculars[0]);
 	perpendiculars[3] = { -perpendiculars[2].x,-perpendiculars[2].y,-perpendiculars[2].z };
 
-	// 平面の四隅を計算
+	// 平面の四隅を計算し、四隅が視錐台の外なら描画しない
 	Vector3 points[4];
 	for (int32_t index = 0; index < 4; index++)
 	{
 		Vector3 extend = Multiply(2.0f, perpendiculars[index]);
-		Vector3 point = Add(center, extend);
-		points[index] = Transform(Transform(point, viewProjectionMatrix), viewportMatrix);
+		points[index] = Add(center, extend);
+	}
+	if (IsOutsideFrustum(screenTransform.frustum, points, 4))
+	{
+		return;
+	}
+	for (Vector3& point : points)
+	{
+		point = Transform(point, screenTransform);
 	}
 
-	Novice::DrawLine((int)points[0].x, (int)points[0].y, (int)points[2].x, (int)points[2].y, color);
-	Novice::DrawLine((int)points[1].x, (int)points[1].y, (int)points[3].x, (int)points[3].y, color);
-	Novice::DrawLine((int)points[2].x, (int)points[2].y, (int)points[1].x, (int)points[1].y, color);
-	Novice::DrawLine((int)points[3].x, (int)points[3].y, (int)points[0].x, (int)points[0].y, color);
+	drawSink_->DrawLine((int)points[0].x, (int)points[0].y, (int)points[2].x, (int)points[2].y, color);
+	drawSink_->DrawLine((int)points[1].x, (int)points[1].y, (int)points[3].x, (int)points[3].y, color);
+	drawSink_->DrawLine((int)points[2].x, (int)points[2].y, (int)points[1].x, (int)points[1].y, color);
+	drawSink_->DrawLine((int)points[3].x, (int)points[3].y, (int)points[0].x, (int)points[0].y, color);
 }
 
-void MathFunction::DrawTriangle(const Triangle& triangle, const Matrix4x4& viewProjectionMatrix, const Matrix4x4& viewportMatrix, uint32_t color)
+void MathFunction::DrawTriangle(const Triangle& triangle, const ScreenTransform& screenTransform, uint32_t color)
 {
+	assert(drawSink_);
+	if (IsOutsideFrustum(screenTransform.frustum, triangle.vertices, 3))
+	{
+		return;
+	}
+
 	Vector3 screenVertices[3];
 	for (int i = 0; i < 3; ++i)
 	{
-		screenVertices[i] = Transform(Transform(triangle.vertices[i], viewProjectionMatrix), viewportMatrix);
+		screenVertices[i] = Transform(triangle.vertices[i], screenTransform);
 	}
-	Novice::DrawTriangle((int)screenVertices[0].x, (int)screenVertices[0].y,
+	drawSink_->DrawTriangle((int)screenVertices[0].x, (int)screenVertices[0].y,
 		(int)screenVertices[1].x, (int)screenVertices[1].y,
 		(int)screenVertices[2].x, (int)screenVertices[2].y,
-		color, kFillModeWireFrame);
+		color);
+}
+
+void MathFunction::DrawAABB(const AABB& aabb, const ScreenTransform& screenTransform, uint32_t color)
+{
+	assert(drawSink_);
+	if (IsCollision(screenTransform.frustum, aabb))
+	{
+		DrawAABBLines(aabb, screenTransform, color);
+	}
+}
+
+void MathFunction::DrawSpheres(const ConstSphereSpan& spheres, const ScreenTransform& screenTransform, uint32_t color)
+{
+	assert(drawSink_);
+	// 一定数ずつ視錐台の外でないものの番号をまとめて求めてから描画する
+	const size_t kChunk = 256;
+	uint32_t indices[kChunk];
+	for (size_t offset = 0; offset < spheres.count; offset += kChunk)
+	{
+		ConstSphereSpan chunk{ spheres.centerX + offset, spheres.centerY + offset, spheres.centerZ + offset, spheres.radius + offset, std::min(kChunk, spheres.count - offset) };
+		uint32_t visibleCount = IsCollisionIndices(screenTransform.frustum, chunk, indices);
+		for (uint32_t v = 0; v < visibleCount; ++v)
+		{
+			size_t i = offset + indices[v];
+			DrawSphereLines(Sphere{ { spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i] }, spheres.radius[i] }, screenTransform, color);
+		}
+	}
+}
+
+void MathFunction::DrawAABBs(const ConstAABBSpan& aabbs, const ScreenTransform& screenTransform, uint32_t color)
+{
+	assert(drawSink_);
+	const size_t kChunk = 256;
+	uint32_t indices[kChunk];
+	for (size_t offset = 0; offset < aabbs.count; offset += kChunk)
+	{
+		ConstAABBSpan chunk{ aabbs.minX + offset, aabbs.minY + offset, aabbs.minZ + offset, aabbs.maxX + offset, aabbs.maxY + offset, aabbs.maxZ + offset, std::min(kChunk, aabbs.count - offset) };
+		uint32_t visibleCount = IsCollisionIndices(screenTransform.frustum, chunk, indices);
+		for (uint32_t v = 0; v < visibleCount; ++v)
+		{
+			size_t i = offset + indices[v];
+			DrawAABBLines(AABB{ { aabbs.minX[i], aabbs.minY[i], aabbs.minZ[i] }, { aabbs.maxX[i], aabbs.maxY[i], aabbs.maxZ[i] } }, screenTransform, color);
+		}
+	}
 }
 
-void MathFunction::DrawAABB(const AABB& aabb, const Matrix4x4& viewProjectionMatrix, const Matrix4x4& viewportMatrix, uint32_t color)
+void MathFunction::DrawAABBLines(const AABB& aabb, const ScreenTransform& screenTransform, uint32_t color)
 {
 	Vector3 vertices[8];
 	vertices[0] = { aabb.min.x, aabb.min.y, aabb.min.z };
@@ -521,144 +1011,405 @@ void MathFunction::DrawAABB(const AABB& aabb, const Matrix4x4& viewProjectionMat
 	vertices[6] = { aabb.min.x, aabb.max.y, aabb.max.z };
 	vertices[7] = { aabb.max.x, aabb.max.y, aabb.max.z };
 
-	for (int i = 0; i < 8; ++i)
+	DrawLineList(LineList{ vertices, 8, kAABBLineIndices, 12 }, screenTransform.matrix, color);
+}
+
+void MathFunction::DrawLineList(const LineList& lineList, const Matrix4x4& screenMatrix, uint32_t color)
+{
+	assert(drawSink_);
+	const uint32_t kStackVertexCount = 512;	//これ以下の頂点数ならスタック上で変換する（球の格子は420頂点）
+
+	// 頂点をまとめてスクリーン座標に変換してから、線ごとに変換済みの頂点を引く
+	Vector3 stackVertices[kStackVertexCount];
+	std::vector<Vector3> heapVertices;
+	Vector3* screenVertices = stackVertices;
+	if (lineList.vertexCount > kStackVertexCount)
 	{
-		vertices[i] = Transform(vertices[i], Multiply(viewProjectionMatrix, viewportMatrix));
+		heapVertices.resize(lineList.vertexCount);
+		screenVertices = heapVertices.data();
 	}
+	TransformPoints(lineList.vertices, lineList.vertexCount, screenMatrix, screenVertices);
 
-	Novice::DrawLine((int)vertices[0].x, (int)vertices[0].y, (int)vertices[1].x, (int)vertices[1].y, color);
-	Novice::DrawLine((int)vertices[0].x, (int)vertices[0].y, (int)vertices[2].x, (int)vertices[2].y, color);
-	Novice::DrawLine((int)vertices[0].x, (int)vertices[0].y, (int)vertices[4].x, (int)vertices[4].y, color);
-	Novice::DrawLine((int)vertices[1].x, (int)vertices[1].y, (int)vertices[3].x, (int)vertices[3].y, color);
-	Novice::DrawLine((int)vertices[1].x, (int)vertices[1].y, (int)vertices[5].x, (int)vertices[5].y, color);
-	Novice::DrawLine((int)vertices[2].x, (int)vertices[2].y, (int)vertices[3].x, (int)vertices[3].y, color);
-	Novice::DrawLine((int)vertices[2].x, (int)vertices[2].y, (int)vertices[6].x, (int)vertices[6].y, color);
-	Novice::DrawLine((int)vertices[3].x, (int)vertices[3].y, (int)vertices[7].x, (int)vertices[7].y, color);
-	Novice::DrawLine((int)vertices[4].x, (int)vertices[4].y, (int)vertices[5].x, (int)vertices[5].y, color);
-	Novice::DrawLine((int)vertices[4].x, (int)vertices[4].y, (int)vertices[6].x, (int)vertices[6].y, color);
-	Novice::DrawLine((int)vertices[5].x, (int)vertices[5].y, (int)vertices[7].x, (int)vertices[7].y, color);
-	Novice::DrawLine((int)vertices[6].x, (int)vertices[6].y, (int)vertices[7].x, (int)vertices[7].y, color);
+	for (uint32_t line = 0; line < lineList.lineCount; ++line)
+	{
+		assert(lineList.indices[line * 2] < lineList.vertexCount && lineList.indices[line * 2 + 1] < lineList.vertexCount);
+		const Vector3& start = screenVertices[lineList.indices[line * 2]];
+		const Vector3& end = screenVertices[lineList.indices[line * 2 + 1]];
+		drawSink_->DrawLine((int)start.x, (int)start.y, (int)end.x, (int)end.y, color);
+	}
 }
 
-void MathFunction::DrawBezier(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, const Matrix4x4& viewProjection, const Matrix4x4& viewportMatrix, uint32_t color)
+void MathFunction::DrawBezier(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, const ScreenTransform& screenTransform, uint32_t color, float pixelTolerance)
 {
-	const int kNumSegments = 100; // ベジエ曲線を描画するためのセグメント数
+	DrawCurve(MakeBezierCurve(controlPoint0, controlPoint1, controlPoint2), screenTransform, color, pixelTolerance);
+}
 
-	for (int i = 0; i < kNumSegments; ++i)
-	{
-		float t1 = static_cast<float>(i) / kNumSegments;
-		float t2 = static_cast<float>(i + 1) / kNumSegments;
+void MathFunction::DrawCatmullRom(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, const Vector3& controlPoint3, const ScreenTransform& screenTransform, uint32_t color, float pixelTolerance)
+{
+	DrawCurve(MakeCatmullRomCurve(controlPoint0, controlPoint1, controlPoint2, controlPoint3), screenTransform, color, pixelTolerance);
+}
 
-		Vector3 point1 = Lerp(Lerp(controlPoint0, controlPoint1, t1), Lerp(controlPoint1, controlPoint2, t1), t1);
-		Vector3 point2 = Lerp(Lerp(controlPoint0, controlPoint1, t2), Lerp(controlPoint1, controlPoint2, t2), t2);
+void MathFunction::DrawCurve(const CubicCurve& curve, const ScreenTransform& screenTransform, uint32_t color, float pixelTolerance)
+{
+	assert(drawSink_);
+	assert(pixelTolerance > 0.0f);
+	const uint32_t kMaxDepth = 5;	//分割の深さの上限（線は最大 4 × 2^5 本）
+	const float toleranceSq = pixelTolerance * pixelTolerance;
 
-		Vector3 screenPoint1 = Transform(point1, viewProjection);
-		screenPoint1 = Transform(screenPoint1, viewportMatrix);
+	//スクリーン上の点pと線分abの距離の2乗
+	auto distanceSq = [](const Vector3& p, const Vector3& a, const Vector3& b)
+		{
+			float abX = b.x - a.x, abY = b.y - a.y;
+			float apX = p.x - a.x, apY = p.y - a.y;
+			float lengthSq = abX * abX + abY * abY;
+			float u = lengthSq > 0.0f ? std::clamp((apX * abX + apY * abY) / lengthSq, 0.0f, 1.0f) : 0.0f;
+			float offsetX = apX - u * abX, offsetY = apY - u * abY;
+			return offsetX * offsetX + offsetY * offsetY;
+		};
+	auto sample = [&](float t) { return Transform(Evaluate(curve, t), screenTransform); };
+
+	//区間。左端は直前に描いた点なので、右端と中点（求め済み）を持つ
+	struct CurveInterval
+	{
+		float tRight, tMiddle;
+		Vector3 right, middle;
+		uint32_t depth;
+	};
+	CurveInterval stack[kMaxDepth + 1];
+	uint32_t stackSize = 0;
+	Vector3 left = sample(0.0f);
+	float tLeft = 0.0f;
+	stack[stackSize++] = CurveInterval{ 1.0f, 0.5f, sample(1.0f), sample(0.5f), 0 };
 
-		Vector3 screenPoint2 = Transform(point2, viewProjection);
-		screenPoint2 = Transform(screenPoint2, viewportMatrix);
+	while (stackSize > 0)
+	{
+		CurveInterval& interval = stack[stackSize - 1];
+		// 4分の1点を求め、左右の半分がそれぞれ1本の線で近似できるかを見る（中点1つだけでは折り返しを見逃す）
+		float tQuarter1 = 0.5f * (tLeft + interval.tMiddle);
+		float tQuarter3 = 0.5f * (interval.tMiddle + interval.tRight);
+		Vector3 quarter1 = sample(tQuarter1);
+		Vector3 quarter3 = sample(tQuarter3);
+		bool isFlat = distanceSq(quarter1, left, interval.middle) <= toleranceSq && distanceSq(quarter3, interval.middle, interval.right) <= toleranceSq;
+
+		if (!isFlat && interval.depth < kMaxDepth)
+		{
+			// 4分の1点がそのまま左右の半分の中点になる。左半分を先に処理する
+			CurveInterval leftHalf{ interval.tMiddle, tQuarter1, interval.middle, quarter1, interval.depth + 1 };
+			interval = CurveInterval{ interval.tRight, tQuarter3, interval.right, quarter3, interval.depth + 1 };
+			stack[stackSize++] = leftHalf;
+			continue;
+		}
 
-		Novice::DrawLine((int)screenPoint1.x, (int)screenPoint1.y, (int)screenPoint2.x, (int)screenPoint2.y, color);
+		// 求めた点を全て使って4本で描く
+		const Vector3 points[5] = { left, quarter1, interval.middle, quarter3, interval.right };
+		for (int i = 0; i < 4; ++i)
+		{
+			drawSink_->DrawLine((int)points[i].x, (int)points[i].y, (int)points[i + 1].x, (int)points[i + 1].y, color);
+		}
+		left = interval.right;
+		tLeft = interval.tRight;
+		--stackSize;
 	}
 }
 
-void MathFunction::DrawControlPoint(const Vector3& controlPoint, const Matrix4x4& viewProjection, const Matrix4x4& viewportMatrix)
+void MathFunction::DrawControlPoint(const Vector3& controlPoint, const ScreenTransform& screenTransform)
 {
 	Sphere sphere = { controlPoint, 0.01f };						// 0.01mの半径の球体
-	DrawSphere(sphere, viewProjection, viewportMatrix, 0x000000);	// 黒色で描画
+	DrawSphere(sphere, screenTransform, 0x000000);	// 黒色で描画
 }
 
-bool MathFunction::IsCollision(const Sphere& s1, const Sphere& s2)
+AABB MathFunction::MakeAABB(const Sphere& sphere)
 {
-	//2つの球の中心点間の距離を求める
-	float distance = Length(Subtract(s2.center, s1.center));
-	// 半径の合計よりも短ければ衝突
-	return distance <= (s1.radius + s2.radius);
+	AABB result{};
+	result.min = { sphere.center.x - sphere.radius, sphere.center.y - sphere.radius, sphere.center.z - sphere.radius };
+	result.max = { sphere.center.x + sphere.radius, sphere.center.y + sphere.radius, sphere.center.z + sphere.radius };
+	return result;
 }
 
-bool MathFunction::IsCollision(const Sphere& sphere, const Plane& plane)
+AABB MathFunction::MakeAABB(const Segment& segment)
 {
-	// 平面の法線ベクトルと球の中心点との距離
-	float distance = Dot(plane.normal, sphere.center) - plane.distance;
-	// その距離が球の半径以下なら衝突している
-	return fabs(distance) <= sphere.radius;
+	Vector3 end = Add(segment.origin, segment.diff);
+	AABB result{};
+	result.min = { std::min(segment.origin.x, end.x), std::min(segment.origin.y, end.y), std::min(segment.origin.z, end.z) };
+	result.max = { std::max(segment.origin.x, end.x), std::max(segment.origin.y, end.y), std::max(segment.origin.z, end.z) };
+	return result;
 }
 
-bool MathFunction::IsCollision(const Segment& segment, const Plane& plane)
+AABB MathFunction::MakeAABB(const CubicCurve& curve)
 {
-	//まず垂直判定を行うために、法線と線の内積を求める
-	float dot = Dot(plane.normal, segment.diff);
+	//1成分の範囲。端点と、微分 c1 + 2c2 t + 3c3 t^2 が0になる(0,1)内の点を比べる
+	auto axisRange = [](float c0, float c1, float c2, float c3, float* lower, float* upper)
+		{
+			const float end = c0 + c1 + c2 + c3;
+			*lower = std::min(c0, end);
+			*upper = std::max(c0, end);
+			auto include = [&](float t)
+				{
+					if (0.0f < t && t < 1.0f)
+					{
+						float value = c0 + t * (c1 + t * (c2 + t * c3));
+						*lower = std::min(*lower, value);
+						*upper = std::max(*upper, value);
+					}
+				};
+			const float a = 3.0f * c3, b = 2.0f * c2;
+			if (a == 0.0f)
+			{
+				if (b != 0.0f)
+				{
+					include(-c1 / b);
+				}
+				return;
+			}
+			const float discriminant = b * b - 4.0f * a * c1;
+			if (discriminant >= 0.0f)
+			{
+				// (-b ± root) / 2a は|a|が|b|より極端に小さいと桁落ちするので、打ち消し合わない側から2つの解を求める
+				const float q = -0.5f * (b + std::copysign(std::sqrt(discriminant), b));
+				include(q / a);
+				if (q != 0.0f)
+				{
+					include(c1 / q);
+				}
+			}
+		};
 
-	//垂直 = 平行であるので、衝突しているはずがない
-	// 浮動小数点数の比較は通常、直接の等号判定は避ける
-	const float epsilon = 1e-6f;
-	if (fabs(dot) < epsilon)
+	const Vector3* c = curve.coefficients;
+	AABB result{};
+	axisRange(c[0].x, c[1].x, c[2].x, c[3].x, &result.min.x, &result.max.x);
+	axisRange(c[0].y, c[1].y, c[2].y, c[3].y, &result.min.y, &result.max.y);
+	axisRange(c[0].z, c[1].z, c[2].z, c[3].z, &result.min.z, &result.max.z);
+	return result;
+}
+
+Sphere MathFunction::MakeSphere(const CubicCurve& curve)
+{
+	// 曲線はベジエ制御点の凸包に入るので、中心から最も遠い制御点までの距離で囲める
+	const Vector3* c = curve.coefficients;
+	const Vector3 controlPoints[4] = {
+		c[0],
+		Add(c[0], Multiply(1.0f / 3.0f, c[1])),
+		Add(c[0], Add(Multiply(2.0f / 3.0f, c[1]), Multiply(1.0f / 3.0f, c[2]))),
+		Add(Add(c[0], c[1]), Add(c[2], c[3])) };
+	AABB bounds = MakeAABB(curve);
+	Sphere result{};
+	result.center = Multiply(0.5f, Add(bounds.min, bounds.max));
+	float radiusSq = 0.0f;
+	for (const Vector3& controlPoint : controlPoints)
 	{
-		return false;
+		Vector3 diff = Subtract(controlPoint, result.center);
+		radiusSq = std::max(radiusSq, Dot(diff, diff));
 	}
-
-	//tを求める
-	float t = (plane.distance - Dot(segment.origin, plane.normal)) / dot;
-
-	//tの値と線の種類によって衝突しているかを判断する
-	return t >= 0.0f && t <= 1.0f;
+	// AABBの対角線の半分の方が小さければそちらを使う
+	result.radius = std::min(std::sqrt(radiusSq), 0.5f * Length(Subtract(bounds.max, bounds.min)));
+	return result;
 }
 
-bool MathFunction::IsCollision(const Triangle& triangle, const Segment& segment)
+bool MathFunction::IsCollision(const Sphere& s1, const Sphere& s2)
 {
-	// 三角形の辺
-	Vector3 edge1 = Subtract(triangle.vertices[1], triangle.vertices[0]);
-	Vector3 edge2 = Subtract(triangle.vertices[2], triangle.vertices[0]);
-
-	// 平面の法線ベクトルを計算
-	Vector3 normal = Cross(edge1, edge2);
-	normal = Normalize(normal);
-
-	// 線分の方向ベクトル
-	Vector3 dir = segment.diff;
-	dir = Normalize(dir);
-
-	// 平面と線分の始点のベクトル
-	Vector3 diff = Subtract(triangle.vertices[0], segment.origin);
+	return IsCollision(s1, s2, nullptr);
+}
 
-	// 線分が平面と平行かどうかをチェック
-	float dotND = Dot(normal, dir);
-	if (fabs(dotND) < 1e-6f)
+bool MathFunction::IsCollision(const Sphere& s1, const Sphere& s2, ContactManifold* contact)
+{
+	//2つの球の中心点間の距離の2乗を求める（平方根は取らない）
+	Vector3 diff = Subtract(s2.center, s1.center);
+	float radiusSum = s1.radius + s2.radius;
+	float distanceSq = Dot(diff, diff);
+	// 半径の合計よりも短ければ衝突
+	bool isHit = distanceSq <= radiusSum * radiusSum;
+	if (isHit && contact)
 	{
-		return false; // 線分が平面と平行
+		// 平方根は衝突したときだけ取る。中心が一致していると向きが決まらないので上向きに押し出す
+		float distance = std::sqrt(distanceSq);
+		contact->normal = distance > FLT_MIN ? Multiply(1.0f / distance, diff) : Vector3{ 0.0f, 1.0f, 0.0f };
+		contact->depth = radiusSum - distance;
+		contact->points[0] = Add(s1.center, Multiply(s1.radius - contact->depth * 0.5f, contact->normal));
+		contact->pointCount = 1;
 	}
+	return isHit;
+}
 
-	// 線分の始点と平面の交点を計算
-	float t = Dot(normal, diff) / dotND;
+bool MathFunction::IsCollision(const Sphere& sphere, const Plane& plane)
+{
+	return IsCollision(sphere, plane, nullptr);
+}
 
-	if (t < 0.0f || t > Length(segment.diff))
+bool MathFunction::IsCollision(const Sphere& sphere, const Plane& plane, ContactManifold* contact)
+{
+	// 平面の法線ベクトルと球の中心点との距離
+	float distance = Dot(plane.normal, sphere.center) - plane.distance;
+	// その距離が球の半径以下なら衝突している
+	bool isHit = fabs(distance) <= sphere.radius;
+	if (isHit && contact)
 	{
-		return false; // 線分上に交点がない
+		// 球から平面へ向かう向き（中心が平面の表側なら法線の逆向き）
+		contact->normal = distance >= 0.0f ? Multiply(-1.0f, plane.normal) : plane.normal;
+		contact->depth = sphere.radius - fabs(distance);
+		contact->points[0] = Subtract(sphere.center, Multiply(distance, plane.normal));
+		contact->pointCount = 1;
 	}
+	return isHit;
+}
+
+bool MathFunction::IsCollision(const Segment& segment, const Plane& plane, float* t)
+{
+	return IntersectPlane(segment.origin, segment.diff, 0.0f, 1.0f, plane, t);
+}
+
+bool MathFunction::IsCollision(const Ray& ray, const Plane& plane, float* t)
+{
+	return IntersectPlane(ray.origin, ray.diff, 0.0f, INFINITY, plane, t);
+}
+
+bool MathFunction::IsCollision(const Line& line, const Plane& plane, float* t)
+{
+	return IntersectPlane(line.origin, line.diff, -INFINITY, INFINITY, plane, t);
+}
+
+bool MathFunction::IsCollision(const Sphere& sphere, const Segment& segment, float* tEnter, float* tExit)
+{
+	return IntersectSphere(segment.origin, segment.diff, 0.0f, 1.0f, sphere, tEnter, tExit);
+}
 
-	Vector3 intersection = Add(segment.origin, Multiply(t, dir));
+bool MathFunction::IsCollision(const Sphere& sphere, const Ray& ray, float* tEnter, float* tExit)
+{
+	return IntersectSphere(ray.origin, ray.diff, 0.0f, INFINITY, sphere, tEnter, tExit);
+}
 
-	// バリツチェックで三角形の内部に交点があるかを確認
-	Vector3 c0 = Cross(Subtract(triangle.vertices[1], triangle.vertices[0]), Subtract(intersection, triangle.vertices[0]));
-	Vector3 c1 = Cross(Subtract(triangle.vertices[2], triangle.vertices[1]), Subtract(intersection, triangle.vertices[1]));
-	Vector3 c2 = Cross(Subtract(triangle.vertices[0], triangle.vertices[2]), Subtract(intersection, triangle.vertices[2]));
+bool MathFunction::IsCollision(const Sphere& sphere, const Line& line, float* tEnter, float* tExit)
+{
+	return IntersectSphere(line.origin, line.diff, -INFINITY, INFINITY, sphere, tEnter, tExit);
+}
+
+bool MathFunction::IsCollision(const Triangle& triangle, const Segment& segment, TriangleHit* hit)
+{
+	return IntersectTriangle(segment.origin, segment.diff, 0.0f, 1.0f, triangle, hit);
+}
 
-	if (Dot(c0, normal) >= 0.0f && Dot(c1, normal) >= 0.0f && Dot(c2, normal) >= 0.0f)
+bool MathFunction::IsCollision(const Triangle& triangle, const Ray& ray, TriangleHit* hit)
+{
+	return IntersectTriangle(ray.origin, ray.diff, 0.0f, INFINITY, triangle, hit);
+}
+
+bool MathFunction::IsCollision(const Triangle& triangle, const Line& line, TriangleHit* hit)
+{
+	return IntersectTriangle(line.origin, line.diff, -INFINITY, INFINITY, triangle, hit);
+}
+
+bool MathFunction::IsCollision(const Triangle& triangle, const Sphere& sphere)
+{
+	//三角形上の最近接点と球の中心の距離の2乗を求める（平方根は取らない）
+	Vector3 diff = Subtract(ClosestPoint(sphere.center, triangle), sphere.center);
+	return Dot(diff, diff) <= sphere.radius * sphere.radius;
+}
+
+bool MathFunction::IsCollision(const Triangle& triangle, const AABB& aabb)
+{
+	// AABBの中心を原点に移し、13本の分離軸（箱の3軸・三角形の法線・箱の軸と辺の外積9本）で投影が離れていないか調べる
+	Vector3 center = Multiply(0.5f, Add(aabb.min, aabb.max));
+	Vector3 extent = Multiply(0.5f, Subtract(aabb.max, aabb.min));
+	Vector3 v0 = Subtract(triangle.vertices[0], center);
+	Vector3 v1 = Subtract(triangle.vertices[1], center);
+	Vector3 v2 = Subtract(triangle.vertices[2], center);
+
+	// 箱の3軸（三角形のAABBと箱の比較）
+	if (std::max({ v0.x, v1.x, v2.x }) < -extent.x || std::min({ v0.x, v1.x, v2.x }) > extent.x ||
+		std::max({ v0.y, v1.y, v2.y }) < -extent.y || std::min({ v0.y, v1.y, v2.y }) > extent.y ||
+		std::max({ v0.z, v1.z, v2.z }) < -extent.z || std::min({ v0.z, v1.z, v2.z }) > extent.z)
 	{
-		return true; // 衝突
+		return false;
 	}
 
-	return false; // 衝突なし
+	// 軸に投影した三角形の区間と、箱の投影半径を比べる
+	auto isSeparated = [&](const Vector3& axis)
+		{
+			float p0 = Dot(v0, axis);
+			float p1 = Dot(v1, axis);
+			float p2 = Dot(v2, axis);
+			float radius = extent.x * std::fabs(axis.x) + extent.y * std::fabs(axis.y) + extent.z * std::fabs(axis.z);
+			return std::max({ p0, p1, p2 }) < -radius || std::min({ p0, p1, p2 }) > radius;
+		};
+
+	// 三角形の法線
+	Vector3 edges[3] = { Subtract(v1, v0), Subtract(v2, v1), Subtract(v0, v2) };
+	if (isSeparated(Cross(edges[0], edges[1])))
+	{
+		return false;
+	}
+	// 箱の軸(x,y,z)と辺の外積
+	for (const Vector3& edge : edges)
+	{
+		if (isSeparated({ 0.0f, -edge.z, edge.y }) || isSeparated({ edge.z, 0.0f, -edge.x }) || isSeparated({ -edge.y, edge.x, 0.0f }))
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
 bool MathFunction::IsCollision(const AABB& aabb1, const AABB& aabb2)
 {
-	return (aabb1.min.x <= aabb2.max.x && aabb1.max.x >= aabb2.min.x) && //x軸
+	return IsCollision(aabb1, aabb2, nullptr);
+}
+
+bool MathFunction::IsCollision(const AABB& aabb1, const AABB& aabb2, ContactManifold* contact)
+{
+	bool isHit = (aabb1.min.x <= aabb2.max.x && aabb1.max.x >= aabb2.min.x) && //x軸
 		(aabb1.min.y <= aabb2.max.y && aabb1.max.y >= aabb2.min.y) &&
 		(aabb1.min.z <= aabb2.max.z && aabb1.max.z >= aabb2.min.z);
+	if (isHit && contact)
+	{
+		// 各軸で2つ目を＋側・－側に押し出すのに必要な距離。最も短いもので押し出す（片方が内包されていても抜け出せる）
+		Vector3 pushPositive = Subtract(aabb1.max, aabb2.min);
+		Vector3 pushNegative = Subtract(aabb2.max, aabb1.min);
+		Vector3 push = { std::min(pushPositive.x, pushNegative.x), std::min(pushPositive.y, pushNegative.y), std::min(pushPositive.z, pushNegative.z) };
+		// 接触点は重なっている箱から求める
+		Vector3 overlapMin = { std::max(aabb1.min.x, aabb2.min.x), std::max(aabb1.min.y, aabb2.min.y), std::max(aabb1.min.z, aabb2.min.z) };
+		Vector3 overlapMax = { std::min(aabb1.max.x, aabb2.max.x), std::min(aabb1.max.y, aabb2.max.y), std::min(aabb1.max.z, aabb2.max.z) };
+		Vector3 middle = Multiply(0.5f, Add(overlapMin, overlapMax));
+		contact->normal = { 0.0f, 0.0f, 0.0f };
+		int axis = 0;
+		if (push.x <= push.y && push.x <= push.z)
+		{
+			contact->normal.x = pushPositive.x <= pushNegative.x ? 1.0f : -1.0f;
+			contact->depth = push.x;
+			overlapMin.x = overlapMax.x = middle.x;
+		}
+		else if (push.y <= push.z)
+		{
+			axis = 1;
+			contact->normal.y = pushPositive.y <= pushNegative.y ? 1.0f : -1.0f;
+			contact->depth = push.y;
+			overlapMin.y = overlapMax.y = middle.y;
+		}
+		else
+		{
+			axis = 2;
+			contact->normal.z = pushPositive.z <= pushNegative.z ? 1.0f : -1.0f;
+			contact->depth = push.z;
+			overlapMin.z = overlapMax.z = middle.z;
+		}
+
+		// 重なった箱を押し出す軸の中央で切った面の四隅（押し出す軸以外の2軸のビットを立てる）
+		int uBit = axis == 0 ? 2 : 1;
+		int vBit = axis == 2 ? 2 : 4;
+		for (int i = 0; i < 4; ++i)
+		{
+			int maxMask = ((i & 1) ? uBit : 0) | ((i & 2) ? vBit : 0);
+			contact->points[i] = { (maxMask & 1) ? overlapMax.x : overlapMin.x, (maxMask & 2) ? overlapMax.y : overlapMin.y, (maxMask & 4) ? overlapMax.z : overlapMin.z };
+		}
+		contact->pointCount = 4;
+	}
+	return isHit;
 }
 
 bool MathFunction::IsCollision(const AABB& aabb, const Sphere& sphere)
+{
+	return IsCollision(aabb, sphere, nullptr);
+}
+
+bool MathFunction::IsCollision(const AABB& aabb, const Sphere& sphere, ContactManifold* contact)
 {
 	//最近接点を求める
 	Vector3 clossestPoint
@@ -667,33 +1418,499 @@ bool MathFunction::IsCollision(const AABB& aabb, const Sphere& sphere)
 		std::clamp(sphere.center.y,aabb.min.y,aabb.max.y),
 		std::clamp(sphere.center.z,aabb.min.z,aabb.max.z)
 	};
-	//最近接点と球の中途の距離を求める
-	float distance = Length(Subtract(clossestPoint, sphere.center));
+	//最近接点と球の中心の距離の2乗を求める（平方根は取らない）
+	Vector3 diff = Subtract(clossestPoint, sphere.center);
+	float distanceSq = Dot(diff, diff);
 	//距離が半径よりも小さければ衝突
-	return distance <= sphere.radius;
+	bool isHit = distanceSq <= sphere.radius * sphere.radius;
+	if (isHit && contact)
+	{
+		if (distanceSq > 0.0f)
+		{
+			// 中心がAABBの外：最近接点から球の中心へ向かって押し出す
+			float distance = std::sqrt(distanceSq);
+			contact->normal = Multiply(-1.0f / distance, diff);
+			contact->depth = sphere.radius - distance;
+		}
+		else
+		{
+			// 中心がAABBの内側：最も近い面から押し出し、最近接点はその面に下ろした点にする
+			float faceDistance[6] =
+			{
+				sphere.center.x - aabb.min.x, aabb.max.x - sphere.center.x,
+				sphere.center.y - aabb.min.y, aabb.max.y - sphere.center.y,
+				sphere.center.z - aabb.min.z, aabb.max.z - sphere.center.z,
+			};
+			int face = int(std::min_element(faceDistance, faceDistance + 6) - faceDistance);
+			float direction = (face & 1) ? 1.0f : -1.0f;
+			contact->normal = { face / 2 == 0 ? direction : 0.0f, face / 2 == 1 ? direction : 0.0f, face / 2 == 2 ? direction : 0.0f };
+			contact->depth = sphere.radius + faceDistance[face];
+			clossestPoint = Add(clossestPoint, Multiply(faceDistance[face], contact->normal));
+		}
+		contact->points[0] = clossestPoint;
+		contact->pointCount = 1;
+	}
+	return isHit;
 }
 
-bool MathFunction::IsCollision(const AABB& aabb, const Segment& segment)
+bool MathFunction::IsCollision(const AABB& aabb, const Plane& plane)
 {
-	float tNearX = (aabb.min.x - segment.origin.x) / segment.diff.x;
-	float tFarX = (aabb.max.x - segment.origin.x) / segment.diff.x;
-	if (tNearX > tFarX) std::swap(tNearX, tFarX);
+	// 中心と平面の距離が、法線方向に投影したAABBの半径以下なら衝突している
+	Vector3 center = Multiply(0.5f, Add(aabb.min, aabb.max));
+	Vector3 extent = Multiply(0.5f, Subtract(aabb.max, aabb.min));
+	float radius = extent.x * std::fabs(plane.normal.x) + extent.y * std::fabs(plane.normal.y) + extent.z * std::fabs(plane.normal.z);
+	return std::fabs(Dot(plane.normal, center) - plane.distance) <= radius;
+}
 
-	float tNearY = (aabb.min.y - segment.origin.y) / segment.diff.y;
-	float tFarY = (aabb.max.y - segment.origin.y) / segment.diff.y;
-	if (tNearY > tFarY) std::swap(tNearY, tFarY);
+bool MathFunction::IsCollision(const AABB& aabb, const Segment& segment, float* tEnter, float* tExit)
+{
+	return IsCollision(aabb, MakeRayQuery(segment), tEnter, tExit);
+}
 
-	float tNearZ = (aabb.min.z - segment.origin.z) / segment.diff.z;
-	float tFarZ = (aabb.max.z - segment.origin.z) / segment.diff.z;
-	if (tNearZ > tFarZ) std::swap(tNearZ, tFarZ);
+bool MathFunction::IsCollision(const AABB& aabb, const Ray& ray, float* tEnter, float* tExit)
+{
+	return IsCollision(aabb, MakeRayQuery(ray), tEnter, tExit);
+}
 
-	// 線分がAABBを貫通しているかどうかを判定
-	float tmin = std::max(std::max(tNearX, tNearY), tNearZ);
-	float tmax = std::min(std::min(tFarX, tFarY), tFarZ);
+bool MathFunction::IsCollision(const AABB& aabb, const Line& line, float* tEnter, float* tExit)
+{
+	return IsCollision(aabb, MakeRayQuery(line), tEnter, tExit);
+}
 
-	// 衝突しているかどうかの判定
-	if (tmin <= tmax && tmax >= 0.0f && tmin <= 1.0f) {
-		return true;
+RayQuery MathFunction::MakeRayQuery(const Ray& ray)
+{
+	RayQuery query{};
+	query.origin = ray.origin;
+	// 0の成分は±無限大になり、スラブの外なら必ず外れ、内側なら制限しない
+	query.inverseDiff = { 1.0f / ray.diff.x, 1.0f / ray.diff.y, 1.0f / ray.diff.z };
+	query.sign[0] = query.inverseDiff.x < 0.0f ? 1 : 0;
+	query.sign[1] = query.inverseDiff.y < 0.0f ? 1 : 0;
+	query.sign[2] = query.inverseDiff.z < 0.0f ? 1 : 0;
+	query.tMin = 0.0f;
+	query.tMax = INFINITY;
+	return query;
+}
+
+RayQuery MathFunction::MakeRayQuery(const Segment& segment)
+{
+	RayQuery query = MakeRayQuery(Ray{ segment.origin, segment.diff });
+	query.tMax = 1.0f;
+	return query;
+}
+
+RayQuery MathFunction::MakeRayQuery(const Line& line)
+{
+	RayQuery query = MakeRayQuery(Ray{ line.origin, line.diff });
+	query.tMin = -INFINITY;
+	return query;
+}
+
+bool MathFunction::IsCollision(const AABB& aabb, const RayQuery& query, float* tEnter, float* tExit)
+{
+	// 符号で近い面と遠い面を選ぶので、tNear > tFar の入れ替えは要らない
+	float tNearX = ((query.sign[0] ? aabb.max.x : aabb.min.x) - query.origin.x) * query.inverseDiff.x;
+	float tFarX = ((query.sign[0] ? aabb.min.x : aabb.max.x) - query.origin.x) * query.inverseDiff.x;
+	float tNearY = ((query.sign[1] ? aabb.max.y : aabb.min.y) - query.origin.y) * query.inverseDiff.y;
+	float tFarY = ((query.sign[1] ? aabb.min.y : aabb.max.y) - query.origin.y) * query.inverseDiff.y;
+	float tNearZ = ((query.sign[2] ? aabb.max.z : aabb.min.z) - query.origin.z) * query.inverseDiff.z;
+	float tFarZ = ((query.sign[2] ? aabb.min.z : aabb.max.z) - query.origin.z) * query.inverseDiff.z;
+
+	// 始点が面上にあり成分が0のときは 0*無限大=NaN になる。比較がfalseになる向きで書き、NaNの軸は無視する
+	float enter = query.tMin;
+	float exit = query.tMax;
+	enter = tNearX > enter ? tNearX : enter;
+	enter = tNearY > enter ? tNearY : enter;
+	enter = tNearZ > enter ? tNearZ : enter;
+	exit = tFarX < exit ? tFarX : exit;
+	exit = tFarY < exit ? tFarY : exit;
+	exit = tFarZ < exit ? tFarZ : exit;
+
+	if (tEnter)
+	{
+		*tEnter = enter;
+	}
+	if (tExit)
+	{
+		*tExit = exit;
+	}
+	return enter <= exit;
+}
+
+bool MathFunction::IsCollision(const Frustum& frustum, const Sphere& sphere)
+{
+	// IsCollision(Sphere, Plane)と同じ符号付き距離で、どれかの平面の裏側に半径より離れていれば外
+	for (const Plane& plane : frustum.planes)
+	{
+		if (Dot(plane.normal, sphere.center) - plane.distance < -sphere.radius)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool MathFunction::IsCollision(const Frustum& frustum, const AABB& aabb)
+{
+	// IsCollision(AABB, Plane)と同じく法線方向に投影した半径を使う
+	Vector3 center = Multiply(0.5f, Add(aabb.min, aabb.max));
+	Vector3 extent = Multiply(0.5f, Subtract(aabb.max, aabb.min));
+	for (const Plane& plane : frustum.planes)
+	{
+		float radius = extent.x * std::fabs(plane.normal.x) + extent.y * std::fabs(plane.normal.y) + extent.z * std::fabs(plane.normal.z);
+		if (Dot(plane.normal, center) - plane.distance < -radius)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool MathFunction::IsCollision(const CubicCurve& curve, const Sphere& sphere)
+{
+	if (!IsCollision(MakeAABB(curve), sphere))
+	{
+		return false;
+	}
+	Vector3 diff = Subtract(ClosestPoint(sphere.center, curve), sphere.center);
+	return Dot(diff, diff) <= sphere.radius * sphere.radius;
+}
+
+bool MathFunction::IsCollision(const CubicCurve& curve, const AABB& aabb)
+{
+	const uint32_t kMaxDepth = 8;	//二分の深さの上限（弦は曲線の1/256の長さ）
+
+	//区間。深さ優先なので、積む数は深さ+1を超えない
+	struct CurveInterval
+	{
+		float t0;
+		float t1;
+		uint32_t depth;
+	};
+	CurveInterval stack[kMaxDepth + 1];
+	uint32_t stackSize = 0;
+	stack[stackSize++] = { 0.0f, 1.0f, 0 };
+	while (stackSize > 0)
+	{
+		const CurveInterval interval = stack[--stackSize];
+		const CubicCurve subCurve = interval.depth == 0 ? curve : MakeSubCurve(curve, interval.t0, interval.t1);
+		const AABB bounds = MakeAABB(subCurve);
+		if (!IsCollision(bounds, aabb))
+		{
+			continue;
+		}
+		// 部分の範囲がAABBに入っていれば、曲線の点がAABBの中にある
+		if (aabb.min.x <= bounds.min.x && bounds.max.x <= aabb.max.x &&
+			aabb.min.y <= bounds.min.y && bounds.max.y <= aabb.max.y &&
+			aabb.min.z <= bounds.min.z && bounds.max.z <= aabb.max.z)
+		{
+			return true;
+		}
+		if (interval.depth == kMaxDepth)
+		{
+			const Vector3* c = subCurve.coefficients;
+			if (IsCollision(aabb, Segment{ c[0], Add(c[1], Add(c[2], c[3])) }))
+			{
+				return true;
+			}
+			continue;
+		}
+		const float middle = 0.5f * (interval.t0 + interval.t1);
+		stack[stackSize++] = { middle, interval.t1, interval.depth + 1 };
+		stack[stackSize++] = { interval.t0, middle, interval.depth + 1 };
 	}
 	return false;
 }
+
+bool MathFunction::IsOutsideFrustum(const Frustum& frustum, const Vector3* points, uint32_t count)
+{
+	for (const Plane& plane : frustum.planes)
+	{
+		uint32_t outsideCount = 0;
+		while (outsideCount < count && Dot(plane.normal, points[outsideCount]) - plane.distance < 0.0f)
+		{
+			++outsideCount;
+		}
+		if (outsideCount == count)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool MathFunction::IntersectPlane(const Vector3& origin, const Vector3& diff, float tMin, float tMax, const Plane& plane, float* t)
+{
+	//まず垂直判定を行うために、法線と線の内積を求める
+	float dot = Dot(plane.normal, diff);
+
+	//垂直 = 平行であるので、衝突しているはずがない
+	// 浮動小数点数の比較は通常、直接の等号判定は避ける
+	const float epsilon = 1e-6f;
+	if (fabs(dot) < epsilon)
+	{
+		return false;
+	}
+
+	//tを求める
+	float hitT = (plane.distance - Dot(origin, plane.normal)) / dot;
+
+	//tの値と線の種類によって衝突しているかを判断する
+	if (hitT < tMin || hitT > tMax)
+	{
+		return false;
+	}
+	if (t)
+	{
+		*t = hitT;
+	}
+	return true;
+}
+
+bool MathFunction::IntersectSphere(const Vector3& origin, const Vector3& diff, float tMin, float tMax, const Sphere& sphere, float* tEnter, float* tExit)
+{
+	// |origin + diff * t - center|^2 = radius^2 を a t^2 + 2 b t + c = 0 として解く
+	Vector3 m = Subtract(origin, sphere.center);
+	float a = Dot(diff, diff);
+	float b = Dot(m, diff);
+	float c = Dot(m, m) - sphere.radius * sphere.radius;
+	if (c > 0.0f && b > 0.0f && tMin >= 0.0f)
+	{
+		return false; // 始点が外側にあり、球から離れる向き（平方根を取らずに外す）
+	}
+	if (a < FLT_MIN)
+	{
+		// 長さ0（または動かない）なら始点が全てのtでの位置。内側なら範囲の最初のtで当たっている
+		if (c > 0.0f)
+		{
+			return false;
+		}
+		if (tEnter)
+		{
+			*tEnter = std::clamp(0.0f, tMin, tMax);
+		}
+		if (tExit)
+		{
+			*tExit = tMax;
+		}
+		return true;
+	}
+	float discriminant = b * b - a * c;
+	if (discriminant < 0.0f)
+	{
+		return false;
+	}
+	float root = std::sqrt(discriminant);
+	float enter = std::max((-b - root) / a, tMin);
+	float exit = std::min((-b + root) / a, tMax);
+	if (enter > exit)
+	{
+		return false;
+	}
+	if (tEnter)
+	{
+		*tEnter = enter;
+	}
+	if (tExit)
+	{
+		*tExit = exit;
+	}
+	return true;
+}
+
+bool MathFunction::IntersectTriangle(const Vector3& origin, const Vector3& diff, float tMin, float tMax, const Triangle& triangle, TriangleHit* hit)
+{
+	// Möller–Trumbore法：交点を重心座標(u,v)と線のtとして直接求める（正規化・平方根なし）
+	Vector3 edge1 = Subtract(triangle.vertices[1], triangle.vertices[0]);
+	Vector3 edge2 = Subtract(triangle.vertices[2], triangle.vertices[0]);
+	Vector3 p = Cross(diff, edge2);
+	float det = Dot(edge1, p);
+	if (std::fabs(det) < FLT_MIN)
+	{
+		return false; // 線が平面と平行、または三角形が縮退している
+	}
+	float inverseDet = 1.0f / det;
+
+	Vector3 s = Subtract(origin, triangle.vertices[0]);
+	float u = Dot(s, p) * inverseDet;
+	if (u < 0.0f || u > 1.0f)
+	{
+		return false;
+	}
+	Vector3 q = Cross(s, edge1);
+	float v = Dot(diff, q) * inverseDet;
+	if (v < 0.0f || u + v > 1.0f)
+	{
+		return false;
+	}
+	float t = Dot(edge2, q) * inverseDet;
+	if (t < tMin || t > tMax)
+	{
+		return false; // 線の範囲に交点がない
+	}
+
+	if (hit)
+	{
+		*hit = TriangleHit{ t, u, v };
+	}
+	return true;
+}
+
+bool MathFunction::IntersectCapsule(const Vector3& origin, const Vector3& diff, const Vector3& start, const Vector3& end, float radius, float* t)
+{
+	// 円柱の側面：軸に垂直な成分だけで、球と同じ形の2次方程式 a t^2 + 2 b t + c = 0 を解く
+	Vector3 axis = Subtract(end, start);
+	Vector3 m = Subtract(origin, start);
+	float axisLengthSq = Dot(axis, axis);
+	float md = Dot(m, axis);
+	float nd = Dot(diff, axis);
+	float a = axisLengthSq * Dot(diff, diff) - nd * nd;
+	float c = axisLengthSq * (Dot(m, m) - radius * radius) - md * md;
+	// 軸と平行に動くとき、始点が無限円柱の内側（=端の球の先）にあるときは側面に当たらないので端の球だけを見る
+	if (a > FLT_EPSILON * axisLengthSq * Dot(diff, diff) && c > 0.0f)
+	{
+		float b = axisLengthSq * Dot(m, diff) - nd * md;
+		float discriminant = b * b - a * c;
+		if (discriminant >= 0.0f)
+		{
+			float hitT = (-b - std::sqrt(discriminant)) / a;
+			float axisT = md + hitT * nd;
+			if (hitT >= 0.0f && hitT <= 1.0f && axisT >= 0.0f && axisT <= axisLengthSq)
+			{
+				*t = hitT;
+				return true;
+			}
+		}
+	}
+
+	// 端の球（カプセルは凸なので、早い方が最初の接触）
+	float best = INFINITY;
+	float sphereT = 0.0f;
+	if (IntersectSphere(origin, diff, 0.0f, 1.0f, Sphere{ start, radius }, &sphereT, nullptr))
+	{
+		best = sphereT;
+	}
+	if (IntersectSphere(origin, diff, 0.0f, 1.0f, Sphere{ end, radius }, &sphereT, nullptr))
+	{
+		best = std::min(best, sphereT);
+	}
+	if (best > 1.0f)
+	{
+		return false;
+	}
+	*t = best;
+	return true;
+}
+
+bool MathFunction::IsCollisionSwept(const Sphere& sphere, const Vector3& velocity, const Plane& plane, float* timeOfImpact)
+{
+	// 平面の法線ベクトルと球の中心点との距離
+	float distance = Dot(plane.normal, sphere.center) - plane.distance;
+	float t = 0.0f;
+	if (fabs(distance) > sphere.radius)
+	{
+		// 平面に近づく向きに動いているときだけ、球の表面が平面に触れる時刻を求める
+		float speed = Dot(plane.normal, velocity);
+		if (distance * speed >= 0.0f)
+		{
+			return false;
+		}
+		t = ((distance > 0.0f ? sphere.radius : -sphere.radius) - distance) / speed;
+		if (t > 1.0f)
+		{
+			return false;
+		}
+	}
+	if (timeOfImpact)
+	{
+		*timeOfImpact = t;
+	}
+	return true;
+}
+
+bool MathFunction::IsCollisionSwept(const Sphere& s1, const Vector3& velocity1, const Sphere& s2, const Vector3& velocity2, float* timeOfImpact)
+{
+	if (IsCollision(s1, s2))
+	{
+		if (timeOfImpact)
+		{
+			*timeOfImpact = 0.0f;
+		}
+		return true;
+	}
+
+	// 球２から見た球１の中心の動きを線分とし、半径の合計の球との交差を求める
+	return IntersectSphere(s1.center, Subtract(velocity1, velocity2), 0.0f, 1.0f, Sphere{ s2.center, s1.radius + s2.radius }, timeOfImpact, nullptr);
+}
+
+bool MathFunction::IsCollisionSwept(const Sphere& sphere, const Vector3& velocity, const AABB& aabb, const Vector3& aabbVelocity, float* timeOfImpact)
+{
+	if (IsCollision(aabb, sphere))
+	{
+		if (timeOfImpact)
+		{
+			*timeOfImpact = 0.0f;
+		}
+		return true;
+	}
+
+	// AABBから見た球の中心の動きを線分とし、AABBを半径だけ太らせた箱と交差させる
+	Vector3 diff = Subtract(velocity, aabbVelocity);
+	Vector3 radius = { sphere.radius, sphere.radius, sphere.radius };
+	AABB expanded{ Subtract(aabb.min, radius), Add(aabb.max, radius) };
+	float t = 0.0f;
+	if (!IsCollision(expanded, Segment{ sphere.center, diff }, &t))
+	{
+		return false;
+	}
+
+	// 交点が元のAABBの外にある軸の数で、面・辺・角のどこに当たったかを分ける（辺と角は丸いのでカプセルで求め直す）
+	Vector3 point = Add(sphere.center, Multiply(t, diff));
+	int lowMask = (point.x < aabb.min.x ? 1 : 0) | (point.y < aabb.min.y ? 2 : 0) | (point.z < aabb.min.z ? 4 : 0);
+	int highMask = (point.x > aabb.max.x ? 1 : 0) | (point.y > aabb.max.y ? 2 : 0) | (point.z > aabb.max.z ? 4 : 0);
+	int outsideMask = lowMask | highMask;
+	auto corner = [&](int maxMask)
+		{
+			return Vector3{ (maxMask & 1) ? aabb.max.x : aabb.min.x, (maxMask & 2) ? aabb.max.y : aabb.min.y, (maxMask & 4) ? aabb.max.z : aabb.min.z };
+		};
+
+	if (outsideMask == 7)
+	{
+		// 角：角の頂点から出る3本の辺のうち、最も早く当たるもの
+		float best = INFINITY;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float edgeT = 0.0f;
+			if (IntersectCapsule(sphere.center, diff, corner(highMask), corner(highMask ^ (1 << axis)), sphere.radius, &edgeT))
+			{
+				best = std::min(best, edgeT);
+			}
+		}
+		if (best > 1.0f)
+		{
+			return false;
+		}
+		t = best;
+	}
+	else if (outsideMask == 3 || outsideMask == 5 || outsideMask == 6)
+	{
+		// 辺：外にある2軸は交点側の端、残りの1軸に沿った辺
+		int insideMask = outsideMask ^ 7;
+		if (!IntersectCapsule(sphere.center, diff, corner(highMask), corner(highMask | insideMask), sphere.radius, &t))
+		{
+			return false;
+		}
+	}
+
+	if (timeOfImpact)
+	{
+		*timeOfImpact = t;
+	}
+	return true;
+}
+
+bool MathFunction::IsCollisionSwept(const AABB& aabb1, const Vector3& velocity1, const AABB& aabb2, const Vector3& velocity2, float* timeOfImpact)
+{
+	// AABB1のminの角を点とみなし、AABB2をAABB1の大きさだけ広げた箱との交差を求める（重なっていればt = 0）
+	AABB expanded{ Subtract(aabb2.min, Subtract(aabb1.max, aabb1.min)), aabb2.max };
+	return IsCollision(expanded, Segment{ aabb1.min, Subtract(velocity1, velocity2) }, timeOfImpact);
+}
@@ -3,16 +3,32 @@
 
 #define NOMINMAX
 #include "AABB.h"
+#include "ContactManifold.h"
+#include "CubicCurve.h"
+#include "DrawSink.h"
+#include "Frustum.h"
 #include "Matrix4x4.h"
 #include "Vector3.h"
 #include "Segment.h"
+#include "Line.h"
+#include "LineList.h"
 #include "Sphereh.h"
 #include "Plane.h"
+#include "Ray.h"
+#include "RayQuery.h"
+#include "ScreenTransform.h"
+#include "ShapeSpan.h"
 #include "Triangle.h"
+#include "TriangleHit.h"
+#include "Vector3Span.h"
 #include <algorithm>
 #include <assert.h>
+#include <cfloat>
+#include <cstdint>
 #include <cmath>
+#ifdef _MSC_VER
 #include <corecrt_math_defines.h>
+#endif
 
 /// <summary>
 /// ベクトルと行列を合わせたクラス
@@ -20,6 +36,8 @@
 class MathFunction
 {
 public:
+	static constexpr float kDefaultPixelTolerance = 0.5f;	//曲線の描画で許す、線と曲線のずれ（ピクセル）
+
 	/*----------Vector型の関数----------*/
 
 	/// <summary>
@@ -84,12 +102,36 @@ public:
 	/// <returns></returns>
 	Vector3 Project(const Vector3& v1, const Vector3& v2);
 	/// <summary>
-	/// 最近接点
+	/// 線分上の最近接点（tは[0,1]に収める。長さ0の線分は始点）
 	/// </summary>
 	/// <param name="point"></param>
 	/// <param name="segment"></param>
+	/// <param name="t">指定すると最近接点のtを受け取る</param>
+	/// <returns></returns>
+	Vector3 ClosestPoint(const Vector3& point, const Segment& segment, float* t = nullptr);
+	/// <summary>
+	/// 半直線上の最近接点（t < 0 は始点に寄せる）
+	/// </summary>
+	/// <param name="point"></param>
+	/// <param name="ray"></param>
+	/// <param name="t">指定すると最近接点のtを受け取る</param>
+	/// <returns></returns>
+	Vector3 ClosestPoint(const Vector3& point, const Ray& ray, float* t = nullptr);
+	/// <summary>
+	/// 直線上の最近接点
+	/// </summary>
+	/// <param name="point"></param>
+	/// <param name="line"></param>
+	/// <param name="t">指定すると最近接点のtを受け取る</param>
+	/// <returns></returns>
+	Vector3 ClosestPoint(const Vector3& point, const Line& line, float* t = nullptr);
+	/// <summary>
+	/// 三角形上の最近接点
+	/// </summary>
+	/// <param name="point"></param>
+	/// <param name="triangle"></param>
 	/// <returns></returns>
-	Vector3 ClosestPoint(const Vector3& point, const Segment& segment);
+	Vector3 ClosestPoint(const Vector3& point, const Triangle& triangle);
 	/// <summary>
 	/// 与えられたベクトルに垂直なベクトルを計算
 	/// </summary>
@@ -107,6 +149,144 @@ public:
 
 	Vector3 CatmullRom(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t);
 
+	/*----------曲線の関数----------*/
+	// 制御点から多項式の係数を1回だけ求め、評価はホーナー法（一括ならSIMD）か前進差分で行う
+
+	/// <summary>
+	/// 2次ベジエ曲線の係数を求める
+	/// </summary>
+	/// <param name="p0"></param>
+	/// <param name="p1"></param>
+	/// <param name="p2"></param>
+	/// <returns></returns>
+	CubicCurve MakeBezierCurve(const Vector3& p0, const Vector3& p1, const Vector3& p2);
+	/// <summary>
+	/// 3次ベジエ曲線の係数を求める
+	/// </summary>
+	/// <param name="p0"></param>
+	/// <param name="p1"></param>
+	/// <param name="p2"></param>
+	/// <param name="p3"></param>
+	/// <returns></returns>
+	CubicCurve MakeBezierCurve(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3);
+	/// <summary>
+	/// Catmull-Rom曲線（p1からp2までの区間）の係数を求める
+	/// </summary>
+	/// <param name="p0"></param>
+	/// <param name="p1"></param>
+	/// <param name="p2"></param>
+	/// <param name="p3"></param>
+	/// <returns></returns>
+	CubicCurve MakeCatmullRomCurve(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3);
+	/// <summary>
+	/// 曲線上の点（ホーナー法）
+	/// </summary>
+	/// <param name="curve"></param>
+	/// <param name="t"></param>
+	/// <returns></returns>
+	Vector3 Evaluate(const CubicCurve& curve, float t);
+	/// <summary>
+	/// 曲線のtでの微分（接線）
+	/// </summary>
+	/// <param name="curve"></param>
+	/// <param name="t"></param>
+	/// <returns></returns>
+	Vector3 EvaluateDerivative(const CubicCurve& curve, float t);
+	/// <summary>
+	/// tを0から1まで等間隔にcount点求める（前進差分。1点あたり加算9回で、最後の点はt=1を直接求める）
+	/// </summary>
+	/// <param name="curve"></param>
+	/// <param name="count">2以上</param>
+	/// <param name="result">要素数分の出力先</param>
+	void EvaluateUniform(const CubicCurve& curve, size_t count, Vector3* result);
+	/// <summary>
+	/// 曲線の[t0,t1]の部分を、tが0～1になるように取り出す
+	/// </summary>
+	/// <param name="curve"></param>
+	/// <param name="t0"></param>
+	/// <param name="t1"></param>
+	/// <returns></returns>
+	CubicCurve MakeSubCurve(const CubicCurve& curve, float t0, float t1);
+	/// <summary>
+	/// 曲線上の最近接点（等間隔の点で当たりをつけ、距離が極小になる点の付近をニュートン法で詰める）
+	/// </summary>
+	/// <param name="point"></param>
+	/// <param name="curve"></param>
+	/// <param name="t">指定すると最近接点のtを受け取る</param>
+	/// <returns></returns>
+	Vector3 ClosestPoint(const Vector3& point, const CubicCurve& curve, float* t = nullptr);
+
+	/*----------Vector型の一括処理関数(SoA)----------*/
+	// AVX2(8要素)/SSE2(4要素)で処理し、端数はスカラーで処理する
+	// 演算順序と丸め(sqrt/除算はIEEE準拠、近似命令は使わない)をスカラー版と揃えている
+	// 許容誤差: Add/Subtract はスカラー版とビット一致(0ULP)
+	//           Dot/Cross/Length/Normalize はコンパイラのFMA縮約の有無で差が出るため、
+	//           最大の積の項を基準に2ULP以内
+	// 入力と出力の要素数は同じであること。出力は入力と同じ配列を指してもよい
+
+	/// <summary>
+	/// 加算（一括）
+	/// </summary>
+	/// <param name="v1"></param>
+	/// <param name="v2"></param>
+	/// <param name="result"></param>
+	void Add(const ConstVector3Span& v1, const ConstVector3Span& v2, const Vector3Span& result);
+	/// <summary>
+	/// 減算（一括）
+	/// </summary>
+	/// <param name="v1"></param>
+	/// <param name="v2"></param>
+	/// <param name="result"></param>
+	void Subtract(const ConstVector3Span& v1, const ConstVector3Span& v2, const Vector3Span& result);
+	/// <summary>
+	/// 内積（一括）
+	/// </summary>
+	/// <param name="v1"></param>
+	/// <param name="v2"></param>
+	/// <param name="result">要素数分の出力先</param>
+	void Dot(const ConstVector3Span& v1, const ConstVector3Span& v2, float* result);
+	/// <summary>
+	/// クロス積（一括）
+	/// </summary>
+	/// <param name="v1"></param>
+	/// <param name="v2"></param>
+	/// <param name="result"></param>
+	void Cross(const ConstVector3Span& v1, const ConstVector3Span& v2, const Vector3Span& result);
+	/// <summary>
+	/// 長さ（一括）
+	/// </summary>
+	/// <param name="v"></param>
+	/// <param name="result">要素数分の出力先</param>
+	void Length(const ConstVector3Span& v, float* result);
+	/// <summary>
+	/// 正規化（一括）長さ0の要素は0ベクトルになる
+	/// </summary>
+	/// <param name="v"></param>
+	/// <param name="result"></param>
+	void Normalize(const ConstVector3Span& v, const Vector3Span& result);
+	/// <summary>
+	/// 座標変換（一括）w除算を行う。行列の4列目が(0,0,0,1)のアフィン行列ならw除算を省略する
+	/// </summary>
+	/// <param name="points"></param>
+	/// <param name="matrix"></param>
+	/// <param name="result">pointsと同じ配列でもよい</param>
+	void TransformPoints(const ConstVector3Span& points, const Matrix4x4& matrix, const Vector3Span& result);
+	/// <summary>
+	/// 座標変換（一括・Vector3配列）w除算を行う。行列の4列目が(0,0,0,1)のアフィン行列ならw除算を省略する
+	/// </summary>
+	/// <param name="points"></param>
+	/// <param name="count"></param>
+	/// <param name="matrix"></param>
+	/// <param name="result">要素数分の出力先。pointsと同じ配列でもよい</param>
+	void TransformPoints(const Vector3* points, size_t count, const Matrix4x4& matrix, Vector3* result);
+	/// <summary>
+	/// 曲線上の点（一括・ホーナー法）
+	/// </summary>
+	/// <param name="curve"></param>
+	/// <param name="ts">result.count個のt</param>
+	/// <param name="result"></param>
+	void Evaluate(const CubicCurve& curve, const float* ts, const Vector3Span& result);
+
 	/*----------Matrix型の関数----------*/
 
 	/// <summary>
@@ -134,8 +314,24 @@ public:
 	/// 逆行列
 	/// </summary>
 	/// <param name="matrix"></param>
+	/// <param name="isInvertible">指定すると逆行列を持つかを受け取る。指定しない場合、特異行列はassertで止める</param>
+	/// <returns>特異行列の場合は単位行列</returns>
+	Matrix4x4 Inverse(const Matrix4x4& matrix, bool* isInvertible = nullptr);
+	/// <summary>
+	/// アフィン行列（拡縮・回転・平行移動）の逆行列
+	/// 3x3部分の逆行列と平行移動の打ち消しだけで求める。4列目が(0,0,0,1)であること
+	/// </summary>
+	/// <param name="matrix"></param>
+	/// <param name="isInvertible">指定すると逆行列を持つかを受け取る。指定しない場合、特異行列はassertで止める</param>
+	/// <returns>特異行列の場合は単位行列</returns>
+	Matrix4x4 InverseAffine(const Matrix4x4& matrix, bool* isInvertible = nullptr);
+	/// <summary>
+	/// 剛体変換行列（回転・平行移動のみ）の逆行列
+	/// 3x3部分を転置し、平行移動を打ち消すだけで求める。拡縮を含む行列には使えない
+	/// </summary>
+	/// <param name="matrix"></param>
 	/// <returns></returns>
-	Matrix4x4 Inverse(const Matrix4x4& matrix);
+	Matrix4x4 InverseRigid(const Matrix4x4& matrix);
 	/// <summary>
 	/// 転置行列
 	/// </summary>
@@ -186,6 +382,14 @@ public:
 	/// <returns></returns>
 	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& radian, const Vector3& translate);
 	/// <summary>
+	/// アフィン変換行列（一括）
+	/// </summary>
+	/// <param name="scale"></param>
+	/// <param name="radian"></param>
+	/// <param name="translate"></param>
+	/// <param name="result">要素数分の出力先</param>
+	void MakeAffineMatrix(const ConstVector3Span& scale, const ConstVector3Span& radian, const ConstVector3Span& translate, Matrix4x4* result);
+	/// <summary>
 	/// 透視投影行列
 	/// </summary>
 	/// <param name="fovY"></param>
@@ -216,67 +420,159 @@ public:
 	/// <param name="maxDepth"></param>
 	/// <returns></returns>
 	Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth);
+	/// <summary>
+	/// スクリーン変換を作成（ビュープロジェクション行列×ビューポート行列をまとめる）
+	/// </summary>
+	/// <param name="viewProjectionMatrix"></param>
+	/// <param name="viewportMatrix"></param>
+	/// <returns></returns>
+	ScreenTransform MakeScreenTransform(const Matrix4x4& viewProjectionMatrix, const Matrix4x4& viewportMatrix);
+	/// <summary>
+	/// ビュープロジェクション行列から視錐台の6平面を取り出す（法線は正規化済み）
+	/// </summary>
+	/// <param name="viewProjectionMatrix"></param>
+	/// <returns></returns>
+	Frustum MakeFrustum(const Matrix4x4& viewProjectionMatrix);
+	/// <summary>
+	/// ワールド座標をスクリーン座標に変換
+	/// </summary>
+	/// <param name="vector"></param>
+	/// <param name="screenTransform"></param>
+	/// <returns></returns>
+	Vector3 Transform(const Vector3& vector, const ScreenTransform& screenTransform);
+	/// <summary>
+	/// ワールド座標からスクリーン座標への変換（一括）
+	/// </summary>
+	/// <param name="points"></param>
+	/// <param name="count"></param>
+	/// <param name="screenTransform"></param>
+	/// <param name="result">要素数分の出力先</param>
+	void TransformPoints(const Vector3* points, size_t count, const ScreenTransform& screenTransform, Vector3* result);
 
 	/*----------立体を描画する関数----------*/
 
+	/// <summary>
+	/// 描画先を設定（Draw系の関数を呼ぶ前に必ず設定する）
+	/// </summary>
+	/// <param name="drawSink">NoviceDrawSinkやLineCommandBufferなど</param>
+	void SetDrawSink(DrawSink* drawSink);
+
 	/// <summary>
 	/// グリッドを描画
 	/// </summary>
-	/// <param name="ViewProjectionMatrix"></param>
-	/// <param name="ViewportMatrix"></param>
-	void DrawGrid(const Matrix4x4& ViewProjectionMatrix, const Matrix4x4& ViewportMatrix);
+	/// <param name="screenTransform"></param>
+	void DrawGrid(const ScreenTransform& screenTransform);
 	/// <summary>
-	/// 球体を描画
+	/// 球体を描画（視錐台の外なら何もしない）
 	/// </summary>
 	/// <param name="sphere"></param>
-	/// <param name="viewProjectionMatrix"></param>
-	/// <param name="viewportMatrix"></param>
+	/// <param name="screenTransform"></param>
 	/// <param name="color"></param>
-	void DrawSphere(const Sphere& sphere, const Matrix4x4& viewProjectionMatrix, const Matrix4x4& viewportMatrix, uint32_t color);
+	void DrawSphere(const Sphere& sphere, const ScreenTransform& screenTransform, uint32_t color);
 	/// <summary>
-	/// 平面を描画
+	/// 平面を描画（視錐台の外なら何もしない）
 	/// </summary>
 	/// <param name="plane"></param>
-	/// <param name="viewProjectionMatrix"></param>
-	/// <param name="viewportMatrix"></param>
+	/// <param name="screenTransform"></param>
 	/// <param name="color"></param>
-	void DrawPlane(const Plane& plane, const Matrix4x4& viewProjectionMatrix, const Matrix4x4& viewportMatrix, uint32_t color);
+	void DrawPlane(const Plane& plane, const ScreenTransform& screenTransform, uint32_t color);
 	/// <summary>
-	/// 三角形を描画
+	/// 三角形を描画（視錐台の外なら何もしない）
 	/// </summary>
 	/// <param name="triangle"></param>
-	/// <param name="viewProjectionMatrix"></param>
-	/// <param name="viewportMatrix"></param>
+	/// <param name="screenTransform"></param>
 	/// <param name="color"></param>
-	void DrawTriangle(const Triangle& triangle, const Matrix4x4& viewProjectionMatrix, const Matrix4x4& viewportMatrix, uint32_t color);
+	void DrawTriangle(const Triangle& triangle, const ScreenTransform& screenTransform, uint32_t color);
 	/// <summary>
-	/// AABBを描画
+	/// AABBを描画（視錐台の外なら何もしない）
 	/// </summary>
 	/// <param name="aabb"></param>
-	/// <param name="viewProjectionMatrix"></param>
-	/// <param name="viewportMatrix"></param>
+	/// <param name="screenTransform"></param>
+	/// <param name="color"></param>
+	void DrawAABB(const AABB& aabb, const ScreenTransform& screenTransform, uint32_t color);
+	/// <summary>
+	/// 球体をまとめて描画（視錐台の外のものは一括判定で先に除く）
+	/// </summary>
+	/// <param name="spheres"></param>
+	/// <param name="screenTransform"></param>
 	/// <param name="color"></param>
-	void DrawAABB(const AABB& aabb, const Matrix4x4& viewProjectionMatrix, const Matrix4x4& viewportMatrix, uint32_t color);
+	void DrawSpheres(const ConstSphereSpan& spheres, const ScreenTransform& screenTransform, uint32_t color);
 	/// <summary>
-	/// ベジエ曲線を描画
+	/// AABBをまとめて描画（視錐台の外のものは一括判定で先に除く）
+	/// </summary>
+	/// <param name="aabbs"></param>
+	/// <param name="screenTransform"></param>
+	/// <param name="color"></param>
+	void DrawAABBs(const ConstAABBSpan& aabbs, const ScreenTransform& screenTransform, uint32_t color);
+	/// <summary>
+	/// 添え字つきの線のリストを描画（頂点をまとめて1回ずつスクリーン座標に変換してから、線を出す。視錐台の判定はしない）
+	/// </summary>
+	/// <param name="lineList"></param>
+	/// <param name="screenMatrix">頂点からスクリーン座標への変換行列（ワールド座標の頂点ならScreenTransformのmatrix）</param>
+	/// <param name="color"></param>
+	void DrawLineList(const LineList& lineList, const Matrix4x4& screenMatrix, uint32_t color);
+	/// <summary>
+	/// ベジエ曲線を描画（スクリーン上の誤差がpixelTolerance以下になるまで分割する）
 	/// </summary>
 	/// <param name="controlPoint0"></param>
 	/// <param name="controlPoint1"></param>
 	/// <param name="controlPoint2"></param>
-	/// <param name="viewProjection"></param>
-	/// <param name="viewportMatrix"></param>
+	/// <param name="screenTransform"></param>
+	/// <param name="color"></param>
+	/// <param name="pixelTolerance">線と曲線のずれの許容量（ピクセル）</param>
+	void DrawBezier(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, const ScreenTransform& screenTransform, uint32_t color, float pixelTolerance = kDefaultPixelTolerance);
+	/// <summary>
+	/// Catmull-Rom曲線を描画（スクリーン上の誤差がpixelTolerance以下になるまで分割する）
+	/// </summary>
+	/// <param name="controlPoint0"></param>
+	/// <param name="controlPoint1"></param>
+	/// <param name="controlPoint2"></param>
+	/// <param name="controlPoint3"></param>
+	/// <param name="screenTransform"></param>
 	/// <param name="color"></param>
-	void DrawBezier(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, const Matrix4x4& viewProjection, const Matrix4x4& viewportMatrix, uint32_t color);
+	/// <param name="pixelTolerance">線と曲線のずれの許容量（ピクセル）</param>
+	void DrawCatmullRom(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, const Vector3& controlPoint3, const ScreenTransform& screenTransform, uint32_t color, float pixelTolerance = kDefaultPixelTolerance);
+	/// <summary>
+	/// 曲線を、スクリーン上で線とのずれがpixelTolerance以下になるまで二分割して描画する（各点は1回だけ評価・変換する）
+	/// </summary>
+	/// <param name="curve"></param>
+	/// <param name="screenTransform"></param>
+	/// <param name="color"></param>
+	/// <param name="pixelTolerance">線と曲線のずれの許容量（ピクセル）</param>
+	void DrawCurve(const CubicCurve& curve, const ScreenTransform& screenTransform, uint32_t color, float pixelTolerance = kDefaultPixelTolerance);
 	/// <summary>
 	/// ベジエ曲線の制御点を描画
 	/// </summary>
 	/// <param name="controlPoint"></param>
-	/// <param name="viewProjection"></param>
-	/// <param name="viewportMatrix"></param>
-	void DrawControlPoint(const Vector3& controlPoint, const Matrix4x4& viewProjection, const Matrix4x4& viewportMatrix);
+	/// <param name="screenTransform"></param>
+	void DrawControlPoint(const Vector3& controlPoint, const ScreenTransform& screenTransform);
 
 	/*----------衝突判定を取る関数----------*/
 
+	/// <summary>
+	/// 球を囲むAABB
+	/// </summary>
+	/// <param name="sphere"></param>
+	/// <returns></returns>
+	AABB MakeAABB(const Sphere& sphere);
+	/// <summary>
+	/// 線分を囲むAABB
+	/// </summary>
+	/// <param name="segment"></param>
+	/// <returns></returns>
+	AABB MakeAABB(const Segment& segment);
+	/// <summary>
+	/// 曲線を囲むAABB（端点と、各成分の微分が0になる点から求めるので隙間がない）
+	/// </summary>
+	/// <param name="curve"></param>
+	/// <returns></returns>
+	AABB MakeAABB(const CubicCurve& curve);
+	/// <summary>
+	/// 曲線を囲む球（AABBの中心から、曲線を囲むベジエ制御点の最も遠い点までを半径にする）
+	/// </summary>
+	/// <param name="curve"></param>
+	/// <returns></returns>
+	Sphere MakeSphere(const CubicCurve& curve);
 	/// <summary>
 	/// 球と球の衝突判定
 	/// </summary>
@@ -285,6 +581,14 @@ public:
 	/// <returns></returns>
 	bool IsCollision(const Sphere& s1, const Sphere& s2);
 	/// <summary>
+	/// 球と球の衝突判定（接触情報つき。接触点は重なりの中央）
+	/// </summary>
+	/// <param name="s1">球１</param>
+	/// <param name="s2">球２</param>
+	/// <param name="contact">衝突していれば接触情報を受け取る（nullptrなら判定だけ）</param>
+	/// <returns></returns>
+	bool IsCollision(const Sphere& s1, const Sphere& s2, ContactManifold* contact);
+	/// <summary>
 	/// 球と平面の衝突判定
 	/// </summary>
 	/// <param name="sphere">球</param>
@@ -292,19 +596,102 @@ public:
 	/// <returns></returns>
 	bool IsCollision(const Sphere& sphere, const Plane& plane);
 	/// <summary>
+	/// 球と平面の衝突判定（接触情報つき。接触点は球の中心を平面に下ろした点）
+	/// </summary>
+	/// <param name="sphere">球</param>
+	/// <param name="plane">平面</param>
+	/// <param name="contact">衝突していれば接触情報を受け取る（nullptrなら判定だけ）</param>
+	/// <returns></returns>
+	bool IsCollision(const Sphere& sphere, const Plane& plane, ContactManifold* contact);
+	/// <summary>
 	/// 線と平面の衝突判定
 	/// </summary>
 	/// <param name="segment">セグメント</param>
 	/// <param name="plane">平面</param>
+	/// <param name="t">指定すると交点のtを受け取る</param>
 	/// <returns></returns>
-	bool IsCollision(const Segment& segment, const Plane& plane);
+	bool IsCollision(const Segment& segment, const Plane& plane, float* t = nullptr);
 	/// <summary>
-	/// 三角形と線の衝突判定
+	/// 半直線と平面の衝突判定
+	/// </summary>
+	/// <param name="ray">半直線</param>
+	/// <param name="plane">平面</param>
+	/// <param name="t">指定すると交点のtを受け取る</param>
+	/// <returns></returns>
+	bool IsCollision(const Ray& ray, const Plane& plane, float* t = nullptr);
+	/// <summary>
+	/// 直線と平面の衝突判定
+	/// </summary>
+	/// <param name="line">直線</param>
+	/// <param name="plane">平面</param>
+	/// <param name="t">指定すると交点のtを受け取る</param>
+	/// <returns></returns>
+	bool IsCollision(const Line& line, const Plane& plane, float* t = nullptr);
+	/// <summary>
+	/// 球と線分の衝突判定
+	/// </summary>
+	/// <param name="sphere">球</param>
+	/// <param name="segment">セグメント</param>
+	/// <param name="tEnter">指定すると入るときのtを受け取る（始点が内側なら0）</param>
+	/// <param name="tExit">指定すると出るときのtを受け取る（終点が内側なら1）</param>
+	/// <returns></returns>
+	bool IsCollision(const Sphere& sphere, const Segment& segment, float* tEnter = nullptr, float* tExit = nullptr);
+	/// <summary>
+	/// 球と半直線の衝突判定
+	/// </summary>
+	/// <param name="sphere">球</param>
+	/// <param name="ray">半直線</param>
+	/// <param name="tEnter">指定すると入るときのtを受け取る（始点が内側なら0）</param>
+	/// <param name="tExit">指定すると出るときのtを受け取る</param>
+	/// <returns></returns>
+	bool IsCollision(const Sphere& sphere, const Ray& ray, float* tEnter = nullptr, float* tExit = nullptr);
+	/// <summary>
+	/// 球と直線の衝突判定
+	/// </summary>
+	/// <param name="sphere">球</param>
+	/// <param name="line">直線</param>
+	/// <param name="tEnter">指定すると入るときのtを受け取る</param>
+	/// <param name="tExit">指定すると出るときのtを受け取る</param>
+	/// <returns></returns>
+	bool IsCollision(const Sphere& sphere, const Line& line, float* tEnter = nullptr, float* tExit = nullptr);
+	/// <summary>
+	/// 三角形と線の衝突判定（Möller–Trumbore法・両面）
 	/// </summary>
 	/// <param name="triangle">三角形</param>
 	/// <param name="segment">セグメント</param>
+	/// <param name="hit">指定すると交点のtと重心座標を受け取る</param>
+	/// <returns></returns>
+	bool IsCollision(const Triangle& triangle, const Segment& segment, TriangleHit* hit = nullptr);
+	/// <summary>
+	/// 三角形と半直線の衝突判定（Möller–Trumbore法・両面）
+	/// </summary>
+	/// <param name="triangle">三角形</param>
+	/// <param name="ray">半直線</param>
+	/// <param name="hit">指定すると交点のtと重心座標を受け取る</param>
+	/// <returns></returns>
+	bool IsCollision(const Triangle& triangle, const Ray& ray, TriangleHit* hit = nullptr);
+	/// <summary>
+	/// 三角形と直線の衝突判定（Möller–Trumbore法・両面）
+	/// </summary>
+	/// <param name="triangle">三角形</param>
+	/// <param name="line">直線</param>
+	/// <param name="hit">指定すると交点のtと重心座標を受け取る（tは負にもなる）</param>
 	/// <returns></returns>
-	bool IsCollision(const Triangle& triangle, const Segment& segment);
+	bool IsCollision(const Triangle& triangle, const Line& line, TriangleHit* hit = nullptr);
+	/// <summary>
+	/// 三角形と球の衝突判定
+	/// </summary>
+	/// <param name="triangle">三角形</param>
+	/// <param name="sphere">球</param>
+	/// <returns></returns>
+	bool IsCollision(const Triangle& triangle, const Sphere& sphere);
+	/// <summary>
+	/// 三角形とAABBの衝突判定（分離軸判定）
+	/// </summary>
+	/// <param name="triangle">三角形</param>
+	/// <param name="aabb">AABB</param>
+	/// <returns></returns>
+	bool IsCollision(const Triangle& triangle, const AABB& aabb);
 	/// <summary>
 	/// AABBとAABBの衝突判定
 	/// </summary>
@@ -313,6 +700,14 @@ public:
 	/// <returns></returns>
 	bool IsCollision(const AABB& aabb1, const AABB& aabb2);
 	/// <summary>
+	/// AABBとAABBの衝突判定（接触情報つき。押し出す距離の最も短い軸で押し出し、重なった面の四隅を接触点にする）
+	/// </summary>
+	/// <param name="aabb1">AABB1</param>
+	/// <param name="aabb2">AABB2</param>
+	/// <param name="contact">衝突していれば接触情報を受け取る（nullptrなら判定だけ）</param>
+	/// <returns></returns>
+	bool IsCollision(const AABB& aabb1, const AABB& aabb2, ContactManifold* contact);
+	/// <summary>
 	/// AABBと球の衝突判定
 	/// </summary>
 	/// <param name="aabb">AABB</param>
@@ -320,11 +715,336 @@ public:
 	/// <returns></returns>
 	bool IsCollision(const AABB& aabb, const Sphere& sphere);
 	/// <summary>
+	/// AABBと球の衝突判定（接触情報つき。接触点はAABB上の最近接点）
+	/// </summary>
+	/// <param name="aabb">AABB</param>
+	/// <param name="sphere">球</param>
+	/// <param name="contact">衝突していれば接触情報を受け取る（nullptrなら判定だけ）</param>
+	/// <returns></returns>
+	bool IsCollision(const AABB& aabb, const Sphere& sphere, ContactManifold* contact);
+	/// <summary>
+	/// AABBと平面の衝突判定
+	/// </summary>
+	/// <param name="aabb">AABB</param>
+	/// <param name="plane">平面</param>
+	/// <returns></returns>
+	bool IsCollision(const AABB& aabb, const Plane& plane);
+	/// <summary>
 	/// AABBと線の衝突判定
 	/// </summary>
 	/// <param name="aabb">AABB</param>
 	/// <param name="segment">セグメント</param>
+	/// <param name="tEnter">指定すると入るときのtを受け取る</param>
+	/// <param name="tExit">指定すると出るときのtを受け取る</param>
+	/// <returns></returns>
+	bool IsCollision(const AABB& aabb, const Segment& segment, float* tEnter = nullptr, float* tExit = nullptr);
+	/// <summary>
+	/// AABBと半直線の衝突判定
+	/// </summary>
+	/// <param name="aabb">AABB</param>
+	/// <param name="ray">半直線</param>
+	/// <param name="tEnter">指定すると入るときのtを受け取る</param>
+	/// <param name="tExit">指定すると出るときのtを受け取る</param>
+	/// <returns></returns>
+	bool IsCollision(const AABB& aabb, const Ray& ray, float* tEnter = nullptr, float* tExit = nullptr);
+	/// <summary>
+	/// AABBと直線の衝突判定
+	/// </summary>
+	/// <param name="aabb">AABB</param>
+	/// <param name="line">直線</param>
+	/// <param name="tEnter">指定すると入るときのtを受け取る</param>
+	/// <param name="tExit">指定すると出るときのtを受け取る</param>
+	/// <returns></returns>
+	bool IsCollision(const AABB& aabb, const Line& line, float* tEnter = nullptr, float* tExit = nullptr);
+	/// <summary>
+	/// 半直線の問い合わせを作る（方向の逆数と符号を前計算）
+	/// </summary>
+	/// <param name="ray"></param>
+	/// <returns></returns>
+	RayQuery MakeRayQuery(const Ray& ray);
+	/// <summary>
+	/// 線分の問い合わせを作る（方向の逆数と符号を前計算）
+	/// </summary>
+	/// <param name="segment"></param>
+	/// <returns></returns>
+	RayQuery MakeRayQuery(const Segment& segment);
+	/// <summary>
+	/// 直線の問い合わせを作る（方向の逆数と符号を前計算）
+	/// </summary>
+	/// <param name="line"></param>
+	/// <returns></returns>
+	RayQuery MakeRayQuery(const Line& line);
+	/// <summary>
+	/// AABBと半直線・線分の衝突判定（スラブ法）。差分の成分が0でもNaNで誤判定しない
+	/// </summary>
+	/// <param name="aabb">AABB</param>
+	/// <param name="query">問い合わせ</param>
+	/// <param name="tEnter">指定すると入るときのtを受け取る</param>
+	/// <param name="tExit">指定すると出るときのtを受け取る</param>
+	/// <returns></returns>
+	bool IsCollision(const AABB& aabb, const RayQuery& query, float* tEnter = nullptr, float* tExit = nullptr);
+
+	/// <summary>
+	/// 視錐台と球の判定（どれかの平面の完全に外側にあるときだけfalse。角の付近では外でもtrueになることがある）
+	/// </summary>
+	/// <param name="frustum">視錐台</param>
+	/// <param name="sphere">球</param>
+	/// <returns></returns>
+	bool IsCollision(const Frustum& frustum, const Sphere& sphere);
+	/// <summary>
+	/// 視錐台とAABBの判定（どれかの平面の完全に外側にあるときだけfalse。角の付近では外でもtrueになることがある）
+	/// </summary>
+	/// <param name="frustum">視錐台</param>
+	/// <param name="aabb">AABB</param>
+	/// <returns></returns>
+	bool IsCollision(const Frustum& frustum, const AABB& aabb);
+	/// <summary>
+	/// 曲線と球の衝突判定（AABBで除外してから、中心への最近接点で判定する）
+	/// </summary>
+	/// <param name="curve">曲線</param>
+	/// <param name="sphere">球</param>
+	/// <returns></returns>
+	bool IsCollision(const CubicCurve& curve, const Sphere& sphere);
+	/// <summary>
+	/// 曲線とAABBの衝突判定（AABBが重なる部分だけ二分し、十分短くなったら弦の線分で判定する）
+	/// </summary>
+	/// <param name="curve">曲線</param>
+	/// <param name="aabb">AABB</param>
+	/// <returns></returns>
+	bool IsCollision(const CubicCurve& curve, const AABB& aabb);
+
+	/*----------移動する形状の衝突判定(連続判定)----------*/
+	// velocityは1ステップの移動量。timeOfImpactは最初に接触する時刻を移動量に対する割合[0,1]で受け取る
+	// 開始時点で重なっていれば0を返す。速い物体が薄い平面や小さいAABBをすり抜けないので、細かく刻んで判定しなくてよい
+
+	/// <summary>
+	/// 移動する球と平面の衝突判定
+	/// </summary>
+	/// <param name="sphere">球</param>
+	/// <param name="velocity">球の移動量</param>
+	/// <param name="plane">平面</param>
+	/// <param name="timeOfImpact">指定すると接触する時刻を受け取る</param>
+	/// <returns></returns>
+	bool IsCollisionSwept(const Sphere& sphere, const Vector3& velocity, const Plane& plane, float* timeOfImpact = nullptr);
+	/// <summary>
+	/// 移動する球と球の衝突判定
+	/// </summary>
+	/// <param name="s1">球１</param>
+	/// <param name="velocity1">球１の移動量</param>
+	/// <param name="s2">球２</param>
+	/// <param name="velocity2">球２の移動量</param>
+	/// <param name="timeOfImpact">指定すると接触する時刻を受け取る</param>
+	/// <returns></returns>
+	bool IsCollisionSwept(const Sphere& s1, const Vector3& velocity1, const Sphere& s2, const Vector3& velocity2, float* timeOfImpact = nullptr);
+	/// <summary>
+	/// 移動する球とAABBの衝突判定
+	/// </summary>
+	/// <param name="sphere">球</param>
+	/// <param name="velocity">球の移動量</param>
+	/// <param name="aabb">AABB</param>
+	/// <param name="aabbVelocity">AABBの移動量</param>
+	/// <param name="timeOfImpact">指定すると接触する時刻を受け取る</param>
+	/// <returns></returns>
+	bool IsCollisionSwept(const Sphere& sphere, const Vector3& velocity, const AABB& aabb, const Vector3& aabbVelocity, float* timeOfImpact = nullptr);
+	/// <summary>
+	/// 移動するAABBとAABBの衝突判定
+	/// </summary>
+	/// <param name="aabb1">AABB1</param>
+	/// <param name="velocity1">AABB1の移動量</param>
+	/// <param name="aabb2">AABB2</param>
+	/// <param name="velocity2">AABB2の移動量</param>
+	/// <param name="timeOfImpact">指定すると接触する時刻を受け取る</param>
 	/// <returns></returns>
-	bool IsCollision(const AABB& aabb, const Segment& segment);
+	bool IsCollisionSwept(const AABB& aabb1, const Vector3& velocity1, const AABB& aabb2, const Vector3& velocity2, float* timeOfImpact = nullptr);
+
+	/*----------衝突判定の一括処理関数(SoA)----------*/
+	// 1つの形状とSoA配列の各要素を、距離の2乗で判定する（AVX2は8要素、SSE2は4要素ずつ）
+	// Maskは要素iの結果を mask[i / 32] の (i % 32) ビット目に書く（(count + 31) / 32 個の出力先が必要）
+	// Indicesは衝突した要素の番号を昇順に詰めて書き、その数を返す（count個の出力先が必要）
+
+	/// <summary>
+	/// 球と球の衝突判定（一括・ビットマスク）
+	/// </summary>
+	/// <param name="sphere"></param>
+	/// <param name="spheres"></param>
+	/// <param name="mask"></param>
+	void IsCollisionMask(const Sphere& sphere, const ConstSphereSpan& spheres, uint32_t* mask);
+	/// <summary>
+	/// 球と球の衝突判定（一括・番号）
+	/// </summary>
+	/// <param name="sphere"></param>
+	/// <param name="spheres"></param>
+	/// <param name="indices"></param>
+	/// <returns>衝突した数</returns>
+	uint32_t IsCollisionIndices(const Sphere& sphere, const ConstSphereSpan& spheres, uint32_t* indices);
+	/// <summary>
+	/// 球とAABBの衝突判定（一括・ビットマスク）
+	/// </summary>
+	/// <param name="sphere"></param>
+	/// <param name="aabbs"></param>
+	/// <param name="mask"></param>
+	void IsCollisionMask(const Sphere& sphere, const ConstAABBSpan& aabbs, uint32_t* mask);
+	/// <summary>
+	/// 球とAABBの衝突判定（一括・番号）
+	/// </summary>
+	/// <param name="sphere"></param>
+	/// <param name="aabbs"></param>
+	/// <param name="indices"></param>
+	/// <returns>衝突した数</returns>
+	uint32_t IsCollisionIndices(const Sphere& sphere, const ConstAABBSpan& aabbs, uint32_t* indices);
+	/// <summary>
+	/// AABBとAABBの衝突判定（一括・ビットマスク）
+	/// </summary>
+	/// <param name="aabb"></param>
+	/// <param name="aabbs"></param>
+	/// <param name="mask"></param>
+	void IsCollisionMask(const AABB& aabb, const ConstAABBSpan& aabbs, uint32_t* mask);
+	/// <summary>
+	/// AABBとAABBの衝突判定（一括・番号）
+	/// </summary>
+	/// <param name="aabb"></param>
+	/// <param name="aabbs"></param>
+	/// <param name="indices"></param>
+	/// <returns>衝突した数</returns>
+	uint32_t IsCollisionIndices(const AABB& aabb, const ConstAABBSpan& aabbs, uint32_t* indices);
+	/// <summary>
+	/// AABBと球の衝突判定（一括・ビットマスク）
+	/// </summary>
+	/// <param name="aabb"></param>
+	/// <param name="spheres"></param>
+	/// <param name="mask"></param>
+	void IsCollisionMask(const AABB& aabb, const ConstSphereSpan& spheres, uint32_t* mask);
+	/// <summary>
+	/// AABBと球の衝突判定（一括・番号）
+	/// </summary>
+	/// <param name="aabb"></param>
+	/// <param name="spheres"></param>
+	/// <param name="indices"></param>
+	/// <returns>衝突した数</returns>
+	uint32_t IsCollisionIndices(const AABB& aabb, const ConstSphereSpan& spheres, uint32_t* indices);
+	/// <summary>
+	/// 半直線・線分とAABBの衝突判定（一括・ビットマスク）
+	/// </summary>
+	/// <param name="query"></param>
+	/// <param name="aabbs"></param>
+	/// <param name="mask"></param>
+	void IsCollisionMask(const RayQuery& query, const ConstAABBSpan& aabbs, uint32_t* mask);
+	/// <summary>
+	/// 半直線・線分とAABBの衝突判定（一括・番号）
+	/// </summary>
+	/// <param name="query"></param>
+	/// <param name="aabbs"></param>
+	/// <param name="indices"></param>
+	/// <param name="tEnters">指定すると衝突した要素の入るときのtを、indicesと同じ順に受け取る</param>
+	/// <returns>衝突した数</returns>
+	uint32_t IsCollisionIndices(const RayQuery& query, const ConstAABBSpan& aabbs, uint32_t* indices, float* tEnters = nullptr);
+	/// <summary>
+	/// 視錐台と球の判定（一括・ビットマスク）
+	/// </summary>
+	/// <param name="frustum"></param>
+	/// <param name="spheres"></param>
+	/// <param name="mask"></param>
+	void IsCollisionMask(const Frustum& frustum, const ConstSphereSpan& spheres, uint32_t* mask);
+	/// <summary>
+	/// 視錐台と球の判定（一括・番号）
+	/// </summary>
+	/// <param name="frustum"></param>
+	/// <param name="spheres"></param>
+	/// <param name="indices"></param>
+	/// <returns>視錐台の外でない数</returns>
+	uint32_t IsCollisionIndices(const Frustum& frustum, const ConstSphereSpan& spheres, uint32_t* indices);
+	/// <summary>
+	/// 視錐台とAABBの判定（一括・ビットマスク）
+	/// </summary>
+	/// <param name="frustum"></param>
+	/// <param name="aabbs"></param>
+	/// <param name="mask"></param>
+	void IsCollisionMask(const Frustum& frustum, const ConstAABBSpan& aabbs, uint32_t* mask);
+	/// <summary>
+	/// 視錐台とAABBの判定（一括・番号）
+	/// </summary>
+	/// <param name="frustum"></param>
+	/// <param name="aabbs"></param>
+	/// <param name="indices"></param>
+	/// <returns>視錐台の外でない数</returns>
+	uint32_t IsCollisionIndices(const Frustum& frustum, const ConstAABBSpan& aabbs, uint32_t* indices);
+
+private:
+	/// <summary>
+	/// 行列式が逆行列を求められる値か（isInvertibleが無ければassertで止める）
+	/// </summary>
+	/// <param name="det"></param>
+	/// <param name="isInvertible"></param>
+	/// <returns></returns>
+	bool IsInvertibleDeterminant(float det, bool* isInvertible);
+	/// <summary>
+	/// 線と平面の交点を、tが[tMin, tMax]の範囲で求める
+	/// </summary>
+	/// <param name="origin"></param>
+	/// <param name="diff"></param>
+	/// <param name="tMin"></param>
+	/// <param name="tMax"></param>
+	/// <param name="plane"></param>
+	/// <param name="t"></param>
+	/// <returns></returns>
+	bool IntersectPlane(const Vector3& origin, const Vector3& diff, float tMin, float tMax, const Plane& plane, float* t);
+	/// <summary>
+	/// 線と球の交差区間を、tが[tMin, tMax]の範囲で求める
+	/// </summary>
+	/// <param name="origin"></param>
+	/// <param name="diff"></param>
+	/// <param name="tMin"></param>
+	/// <param name="tMax"></param>
+	/// <param name="sphere"></param>
+	/// <param name="tEnter"></param>
+	/// <param name="tExit"></param>
+	/// <returns></returns>
+	bool IntersectSphere(const Vector3& origin, const Vector3& diff, float tMin, float tMax, const Sphere& sphere, float* tEnter, float* tExit);
+	/// <summary>
+	/// 線と三角形の交点を、tが[tMin, tMax]の範囲で求める（Möller–Trumbore法・両面）
+	/// </summary>
+	/// <param name="origin"></param>
+	/// <param name="diff"></param>
+	/// <param name="tMin"></param>
+	/// <param name="tMax"></param>
+	/// <param name="triangle"></param>
+	/// <param name="hit"></param>
+	/// <returns></returns>
+	bool IntersectTriangle(const Vector3& origin, const Vector3& diff, float tMin, float tMax, const Triangle& triangle, TriangleHit* hit);
+	/// <summary>
+	/// 線分とカプセル（startからendまでの線分を半径radiusで太らせた形状）が最初に交わるtを求める。始点はカプセルの外にあること
+	/// </summary>
+	/// <param name="origin"></param>
+	/// <param name="diff"></param>
+	/// <param name="start"></param>
+	/// <param name="end"></param>
+	/// <param name="radius"></param>
+	/// <param name="t"></param>
+	/// <returns></returns>
+	bool IntersectCapsule(const Vector3& origin, const Vector3& diff, const Vector3& start, const Vector3& end, float radius, float* t);
+	/// <summary>
+	/// 点が全て視錐台のどれか1枚の平面の外側にあるか（点の凸包が視錐台の外か）
+	/// </summary>
+	/// <param name="frustum"></param>
+	/// <param name="points"></param>
+	/// <param name="count"></param>
+	/// <returns></returns>
+	bool IsOutsideFrustum(const Frustum& frustum, const Vector3* points, uint32_t count);
+	/// <summary>
+	/// 球体の線を描画（視錐台の判定はしない）
+	/// </summary>
+	/// <param name="sphere"></param>
+	/// <param name="screenTransform"></param>
+	/// <param name="color"></param>
+	void DrawSphereLines(const Sphere& sphere, const ScreenTransform& screenTransform, uint32_t color);
+	/// <summary>
+	/// AABBの線を描画（視錐台の判定はしない）
+	/// </summary>
+	/// <param name="aabb"></param>
+	/// <param name="screenTransform"></param>
+	/// <param name="color"></param>
+	void DrawAABBLines(const AABB& aabb, const ScreenTransform& screenTransform, uint32_t color);
+
+	DrawSink* drawSink_ = nullptr;	//描画先
 };
 #endif // MATHFUNCTION_H
\ No newline at end of file
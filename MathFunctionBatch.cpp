@@ -0,0 +1,396 @@
+#include "MathFunction.h"
+#include "SimdConfig.h"
+
+// SoA形式の一括処理。SIMDで割り切れない端数はスカラー版の関数をそのまま呼ぶ
+
+void MathFunction::Add(const ConstVector3Span& v1, const ConstVector3Span& v2, const Vector3Span& result)
+{
+	assert(v1.count == v2.count && v1.count == result.count);
+	const size_t count = result.count;
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 x = _mm256_add_ps(_mm256_loadu_ps(v1.x + i), _mm256_loadu_ps(v2.x + i));
+		__m256 y = _mm256_add_ps(_mm256_loadu_ps(v1.y + i), _mm256_loadu_ps(v2.y + i));
+		__m256 z = _mm256_add_ps(_mm256_loadu_ps(v1.z + i), _mm256_loadu_ps(v2.z + i));
+		_mm256_storeu_ps(result.x + i, x);
+		_mm256_storeu_ps(result.y + i, y);
+		_mm256_storeu_ps(result.z + i, z);
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_add_ps(_mm_loadu_ps(v1.x + i), _mm_loadu_ps(v2.x + i));
+		__m128 y = _mm_add_ps(_mm_loadu_ps(v1.y + i), _mm_loadu_ps(v2.y + i));
+		__m128 z = _mm_add_ps(_mm_loadu_ps(v1.z + i), _mm_loadu_ps(v2.z + i));
+		_mm_storeu_ps(result.x + i, x);
+		_mm_storeu_ps(result.y + i, y);
+		_mm_storeu_ps(result.z + i, z);
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		Vector3 r = Add(Vector3{ v1.x[i], v1.y[i], v1.z[i] }, Vector3{ v2.x[i], v2.y[i], v2.z[i] });
+		result.x[i] = r.x;
+		result.y[i] = r.y;
+		result.z[i] = r.z;
+	}
+}
+
+void MathFunction::Subtract(const ConstVector3Span& v1, const ConstVector3Span& v2, const Vector3Span& result)
+{
+	assert(v1.count == v2.count && v1.count == result.count);
+	const size_t count = result.count;
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 x = _mm256_sub_ps(_mm256_loadu_ps(v1.x + i), _mm256_loadu_ps(v2.x + i));
+		__m256 y = _mm256_sub_ps(_mm256_loadu_ps(v1.y + i), _mm256_loadu_ps(v2.y + i));
+		__m256 z = _mm256_sub_ps(_mm256_loadu_ps(v1.z + i), _mm256_loadu_ps(v2.z + i));
+		_mm256_storeu_ps(result.x + i, x);
+		_mm256_storeu_ps(result.y + i, y);
+		_mm256_storeu_ps(result.z + i, z);
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_sub_ps(_mm_loadu_ps(v1.x + i), _mm_loadu_ps(v2.x + i));
+		__m128 y = _mm_sub_ps(_mm_loadu_ps(v1.y + i), _mm_loadu_ps(v2.y + i));
+		__m128 z = _mm_sub_ps(_mm_loadu_ps(v1.z + i), _mm_loadu_ps(v2.z + i));
+		_mm_storeu_ps(result.x + i, x);
+		_mm_storeu_ps(result.y + i, y);
+		_mm_storeu_ps(result.z + i, z);
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		Vector3 r = Subtract(Vector3{ v1.x[i], v1.y[i], v1.z[i] }, Vector3{ v2.x[i], v2.y[i], v2.z[i] });
+		result.x[i] = r.x;
+		result.y[i] = r.y;
+		result.z[i] = r.z;
+	}
+}
+
+void MathFunction::Dot(const ConstVector3Span& v1, const ConstVector3Span& v2, float* result)
+{
+	assert(v1.count == v2.count);
+	const size_t count = v1.count;
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 d = _mm256_mul_ps(_mm256_loadu_ps(v1.x + i), _mm256_loadu_ps(v2.x + i));
+		d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_loadu_ps(v1.y + i), _mm256_loadu_ps(v2.y + i)));
+		d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_loadu_ps(v1.z + i), _mm256_loadu_ps(v2.z + i)));
+		_mm256_storeu_ps(result + i, d);
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 d = _mm_mul_ps(_mm_loadu_ps(v1.x + i), _mm_loadu_ps(v2.x + i));
+		d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(v1.y + i), _mm_loadu_ps(v2.y + i)));
+		d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(v1.z + i), _mm_loadu_ps(v2.z + i)));
+		_mm_storeu_ps(result + i, d);
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		result[i] = Dot(Vector3{ v1.x[i], v1.y[i], v1.z[i] }, Vector3{ v2.x[i], v2.y[i], v2.z[i] });
+	}
+}
+
+void MathFunction::Cross(const ConstVector3Span& v1, const ConstVector3Span& v2, const Vector3Span& result)
+{
+	assert(v1.count == v2.count && v1.count == result.count);
+	const size_t count = result.count;
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 ax = _mm256_loadu_ps(v1.x + i), ay = _mm256_loadu_ps(v1.y + i), az = _mm256_loadu_ps(v1.z + i);
+		__m256 bx = _mm256_loadu_ps(v2.x + i), by = _mm256_loadu_ps(v2.y + i), bz = _mm256_loadu_ps(v2.z + i);
+		// 入力を全て読み込んでから書き込むので、出力が入力と同じ配列でもよい
+		_mm256_storeu_ps(result.x + i, _mm256_sub_ps(_mm256_mul_ps(ay, bz), _mm256_mul_ps(az, by)));
+		_mm256_storeu_ps(result.y + i, _mm256_sub_ps(_mm256_mul_ps(az, bx), _mm256_mul_ps(ax, bz)));
+		_mm256_storeu_ps(result.z + i, _mm256_sub_ps(_mm256_mul_ps(ax, by), _mm256_mul_ps(ay, bx)));
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 ax = _mm_loadu_ps(v1.x + i), ay = _mm_loadu_ps(v1.y + i), az = _mm_loadu_ps(v1.z + i);
+		__m128 bx = _mm_loadu_ps(v2.x + i), by = _mm_loadu_ps(v2.y + i), bz = _mm_loadu_ps(v2.z + i);
+		_mm_storeu_ps(result.x + i, _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+		_mm_storeu_ps(result.y + i, _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+		_mm_storeu_ps(result.z + i, _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		Vector3 r = Cross(Vector3{ v1.x[i], v1.y[i], v1.z[i] }, Vector3{ v2.x[i], v2.y[i], v2.z[i] });
+		result.x[i] = r.x;
+		result.y[i] = r.y;
+		result.z[i] = r.z;
+	}
+}
+
+void MathFunction::Length(const ConstVector3Span& v, float* result)
+{
+	const size_t count = v.count;
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 x = _mm256_loadu_ps(v.x + i), y = _mm256_loadu_ps(v.y + i), z = _mm256_loadu_ps(v.z + i);
+		__m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+		_mm256_storeu_ps(result + i, _mm256_sqrt_ps(sq));
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(v.x + i), y = _mm_loadu_ps(v.y + i), z = _mm_loadu_ps(v.z + i);
+		__m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+		_mm_storeu_ps(result + i, _mm_sqrt_ps(sq));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		result[i] = Length(Vector3{ v.x[i], v.y[i], v.z[i] });
+	}
+}
+
+void MathFunction::Normalize(const ConstVector3Span& v, const Vector3Span& result)
+{
+	assert(v.count == result.count);
+	const size_t count = result.count;
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	const __m256 zero8 = _mm256_setzero_ps();
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 x = _mm256_loadu_ps(v.x + i), y = _mm256_loadu_ps(v.y + i), z = _mm256_loadu_ps(v.z + i);
+		__m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+		__m256 length = _mm256_sqrt_ps(sq);
+		// 長さ0のレーンは0ベクトル、NaNのレーンはNaN（スカラー版・SSE2版と同じ。比較は順序なし）
+		__m256 mask = _mm256_cmp_ps(length, zero8, _CMP_NEQ_UQ);
+		_mm256_storeu_ps(result.x + i, _mm256_and_ps(_mm256_div_ps(x, length), mask));
+		_mm256_storeu_ps(result.y + i, _mm256_and_ps(_mm256_div_ps(y, length), mask));
+		_mm256_storeu_ps(result.z + i, _mm256_and_ps(_mm256_div_ps(z, length), mask));
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	const __m128 zero4 = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(v.x + i), y = _mm_loadu_ps(v.y + i), z = _mm_loadu_ps(v.z + i);
+		__m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+		__m128 length = _mm_sqrt_ps(sq);
+		__m128 mask = _mm_cmpneq_ps(length, zero4);
+		_mm_storeu_ps(result.x + i, _mm_and_ps(_mm_div_ps(x, length), mask));
+		_mm_storeu_ps(result.y + i, _mm_and_ps(_mm_div_ps(y, length), mask));
+		_mm_storeu_ps(result.z + i, _mm_and_ps(_mm_div_ps(z, length), mask));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		Vector3 r = Normalize(Vector3{ v.x[i], v.y[i], v.z[i] });
+		result.x[i] = r.x;
+		result.y[i] = r.y;
+		result.z[i] = r.z;
+	}
+}
+
+namespace
+{
+#if defined(MATH_SIMD_SSE2)
+	// 行列の4列目が(0,0,0,1)ならw除算は不要
+	bool IsAffine(const Matrix4x4& matrix)
+	{
+		return matrix.m[0][3] == 0.0f && matrix.m[1][3] == 0.0f && matrix.m[2][3] == 0.0f && matrix.m[3][3] == 1.0f;
+	}
+
+	// 4点分(SoA)を変換する。スカラー版のTransformと同じ順序で演算する
+	void TransformLanes(__m128& x, __m128& y, __m128& z, const Matrix4x4& m, bool isAffine)
+	{
+		const __m128 one = _mm_set1_ps(1.0f);
+		__m128 rx = _mm_mul_ps(x, _mm_set1_ps(m.m[0][0]));
+		rx = _mm_add_ps(rx, _mm_mul_ps(y, _mm_set1_ps(m.m[1][0])));
+		rx = _mm_add_ps(rx, _mm_mul_ps(z, _mm_set1_ps(m.m[2][0])));
+		rx = _mm_add_ps(rx, _mm_mul_ps(one, _mm_set1_ps(m.m[3][0])));
+		__m128 ry = _mm_mul_ps(x, _mm_set1_ps(m.m[0][1]));
+		ry = _mm_add_ps(ry, _mm_mul_ps(y, _mm_set1_ps(m.m[1][1])));
+		ry = _mm_add_ps(ry, _mm_mul_ps(z, _mm_set1_ps(m.m[2][1])));
+		ry = _mm_add_ps(ry, _mm_mul_ps(one, _mm_set1_ps(m.m[3][1])));
+		__m128 rz = _mm_mul_ps(x, _mm_set1_ps(m.m[0][2]));
+		rz = _mm_add_ps(rz, _mm_mul_ps(y, _mm_set1_ps(m.m[1][2])));
+		rz = _mm_add_ps(rz, _mm_mul_ps(z, _mm_set1_ps(m.m[2][2])));
+		rz = _mm_add_ps(rz, _mm_mul_ps(one, _mm_set1_ps(m.m[3][2])));
+		if (!isAffine)
+		{
+			__m128 w = _mm_mul_ps(x, _mm_set1_ps(m.m[0][3]));
+			w = _mm_add_ps(w, _mm_mul_ps(y, _mm_set1_ps(m.m[1][3])));
+			w = _mm_add_ps(w, _mm_mul_ps(z, _mm_set1_ps(m.m[2][3])));
+			w = _mm_add_ps(w, _mm_mul_ps(one, _mm_set1_ps(m.m[3][3])));
+			assert(_mm_movemask_ps(_mm_cmpeq_ps(w, _mm_setzero_ps())) == 0);
+			rx = _mm_div_ps(rx, w);
+			ry = _mm_div_ps(ry, w);
+			rz = _mm_div_ps(rz, w);
+		}
+		x = rx;
+		y = ry;
+		z = rz;
+	}
+#endif
+
+#if defined(MATH_SIMD_AVX2)
+	// 8点分(SoA)を変換する
+	void TransformLanes(__m256& x, __m256& y, __m256& z, const Matrix4x4& m, bool isAffine)
+	{
+		const __m256 one = _mm256_set1_ps(1.0f);
+		__m256 rx = _mm256_mul_ps(x, _mm256_set1_ps(m.m[0][0]));
+		rx = _mm256_add_ps(rx, _mm256_mul_ps(y, _mm256_set1_ps(m.m[1][0])));
+		rx = _mm256_add_ps(rx, _mm256_mul_ps(z, _mm256_set1_ps(m.m[2][0])));
+		rx = _mm256_add_ps(rx, _mm256_mul_ps(one, _mm256_set1_ps(m.m[3][0])));
+		__m256 ry = _mm256_mul_ps(x, _mm256_set1_ps(m.m[0][1]));
+		ry = _mm256_add_ps(ry, _mm256_mul_ps(y, _mm256_set1_ps(m.m[1][1])));
+		ry = _mm256_add_ps(ry, _mm256_mul_ps(z, _mm256_set1_ps(m.m[2][1])));
+		ry = _mm256_add_ps(ry, _mm256_mul_ps(one, _mm256_set1_ps(m.m[3][1])));
+		__m256 rz = _mm256_mul_ps(x, _mm256_set1_ps(m.m[0][2]));
+		rz = _mm256_add_ps(rz, _mm256_mul_ps(y, _mm256_set1_ps(m.m[1][2])));
+		rz = _mm256_add_ps(rz, _mm256_mul_ps(z, _mm256_set1_ps(m.m[2][2])));
+		rz = _mm256_add_ps(rz, _mm256_mul_ps(one, _mm256_set1_ps(m.m[3][2])));
+		if (!isAffine)
+		{
+			__m256 w = _mm256_mul_ps(x, _mm256_set1_ps(m.m[0][3]));
+			w = _mm256_add_ps(w, _mm256_mul_ps(y, _mm256_set1_ps(m.m[1][3])));
+			w = _mm256_add_ps(w, _mm256_mul_ps(z, _mm256_set1_ps(m.m[2][3])));
+			w = _mm256_add_ps(w, _mm256_mul_ps(one, _mm256_set1_ps(m.m[3][3])));
+			assert(_mm256_movemask_ps(_mm256_cmp_ps(w, _mm256_setzero_ps(), _CMP_EQ_OQ)) == 0);
+			rx = _mm256_div_ps(rx, w);
+			ry = _mm256_div_ps(ry, w);
+			rz = _mm256_div_ps(rz, w);
+		}
+		x = rx;
+		y = ry;
+		z = rz;
+	}
+#endif
+}
+
+void MathFunction::TransformPoints(const ConstVector3Span& points, const Matrix4x4& matrix, const Vector3Span& result)
+{
+	assert(points.count == result.count);
+	const size_t count = result.count;
+	size_t i = 0;
+#if defined(MATH_SIMD_SSE2)
+	const bool isAffine = IsAffine(matrix);
+#endif
+#if defined(MATH_SIMD_AVX2)
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 x = _mm256_loadu_ps(points.x + i), y = _mm256_loadu_ps(points.y + i), z = _mm256_loadu_ps(points.z + i);
+		TransformLanes(x, y, z, matrix, isAffine);
+		_mm256_storeu_ps(result.x + i, x);
+		_mm256_storeu_ps(result.y + i, y);
+		_mm256_storeu_ps(result.z + i, z);
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(points.x + i), y = _mm_loadu_ps(points.y + i), z = _mm_loadu_ps(points.z + i);
+		TransformLanes(x, y, z, matrix, isAffine);
+		_mm_storeu_ps(result.x + i, x);
+		_mm_storeu_ps(result.y + i, y);
+		_mm_storeu_ps(result.z + i, z);
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		Vector3 r = Transform(Vector3{ points.x[i], points.y[i], points.z[i] }, matrix);
+		result.x[i] = r.x;
+		result.y[i] = r.y;
+		result.z[i] = r.z;
+	}
+}
+
+void MathFunction::TransformPoints(const Vector3* points, size_t count, const Matrix4x4& matrix, Vector3* result)
+{
+	static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 must be three packed floats");
+	size_t i = 0;
+#if defined(MATH_SIMD_SSE2)
+	const bool isAffine = IsAffine(matrix);
+	for (; i + 4 <= count; i += 4)
+	{
+		// 4点(12個のfloat)を読み込み、x/y/zのレーンに並べ替える
+		const float* src = &points[i].x;
+		__m128 a = _mm_loadu_ps(src);		// x0 y0 z0 x1
+		__m128 b = _mm_loadu_ps(src + 4);	// y1 z1 x2 y2
+		__m128 c = _mm_loadu_ps(src + 8);	// z2 x3 y3 z3
+		__m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+		__m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		__m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+		TransformLanes(x, y, z, matrix, isAffine);
+
+		// x/y/zのレーンから元の並びに戻して書き込む
+		float* dst = &result[i].x;
+		_mm_storeu_ps(dst, _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(dst + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(dst + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		result[i] = Transform(points[i], matrix);
+	}
+}
+
+void MathFunction::Evaluate(const CubicCurve& curve, const float* ts, const Vector3Span& result)
+{
+	const Vector3* c = curve.coefficients;
+	const size_t count = result.count;
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	{
+		// c0 + t * (c1 + t * (c2 + t * c3)) を成分ごとに8個のtで求める
+		const __m256 c0x = _mm256_set1_ps(c[0].x), c1x = _mm256_set1_ps(c[1].x), c2x = _mm256_set1_ps(c[2].x), c3x = _mm256_set1_ps(c[3].x);
+		const __m256 c0y = _mm256_set1_ps(c[0].y), c1y = _mm256_set1_ps(c[1].y), c2y = _mm256_set1_ps(c[2].y), c3y = _mm256_set1_ps(c[3].y);
+		const __m256 c0z = _mm256_set1_ps(c[0].z), c1z = _mm256_set1_ps(c[1].z), c2z = _mm256_set1_ps(c[2].z), c3z = _mm256_set1_ps(c[3].z);
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 t = _mm256_loadu_ps(ts + i);
+			_mm256_storeu_ps(result.x + i, _mm256_add_ps(c0x, _mm256_mul_ps(t, _mm256_add_ps(c1x, _mm256_mul_ps(t, _mm256_add_ps(c2x, _mm256_mul_ps(t, c3x)))))));
+			_mm256_storeu_ps(result.y + i, _mm256_add_ps(c0y, _mm256_mul_ps(t, _mm256_add_ps(c1y, _mm256_mul_ps(t, _mm256_add_ps(c2y, _mm256_mul_ps(t, c3y)))))));
+			_mm256_storeu_ps(result.z + i, _mm256_add_ps(c0z, _mm256_mul_ps(t, _mm256_add_ps(c1z, _mm256_mul_ps(t, _mm256_add_ps(c2z, _mm256_mul_ps(t, c3z)))))));
+		}
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	{
+		const __m128 c0x = _mm_set1_ps(c[0].x), c1x = _mm_set1_ps(c[1].x), c2x = _mm_set1_ps(c[2].x), c3x = _mm_set1_ps(c[3].x);
+		const __m128 c0y = _mm_set1_ps(c[0].y), c1y = _mm_set1_ps(c[1].y), c2y = _mm_set1_ps(c[2].y), c3y = _mm_set1_ps(c[3].y);
+		const __m128 c0z = _mm_set1_ps(c[0].z), c1z = _mm_set1_ps(c[1].z), c2z = _mm_set1_ps(c[2].z), c3z = _mm_set1_ps(c[3].z);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 t = _mm_loadu_ps(ts + i);
+			_mm_storeu_ps(result.x + i, _mm_add_ps(c0x, _mm_mul_ps(t, _mm_add_ps(c1x, _mm_mul_ps(t, _mm_add_ps(c2x, _mm_mul_ps(t, c3x)))))));
+			_mm_storeu_ps(result.y + i, _mm_add_ps(c0y, _mm_mul_ps(t, _mm_add_ps(c1y, _mm_mul_ps(t, _mm_add_ps(c2y, _mm_mul_ps(t, c3y)))))));
+			_mm_storeu_ps(result.z + i, _mm_add_ps(c0z, _mm_mul_ps(t, _mm_add_ps(c1z, _mm_mul_ps(t, _mm_add_ps(c2z, _mm_mul_ps(t, c3z)))))));
+		}
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		Vector3 r = Evaluate(curve, ts[i]);
+		result.x[i] = r.x;
+		result.y[i] = r.y;
+		result.z[i] = r.z;
+	}
+}
@@ -0,0 +1,490 @@
+#include "MathFunction.h"
+#include "SimdConfig.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// 衝突判定の一括処理。SIMDで割り切れない端数はスカラー版の関数をそのまま呼ぶ
+
+namespace
+{
+	// 出力先のビットマスクを0で埋める
+	void ClearMask(size_t count, uint32_t* mask)
+	{
+		for (size_t w = 0; w < (count + 31) / 32; ++w)
+		{
+			mask[w] = 0;
+		}
+	}
+
+	uint32_t CountTrailingZeros(uint32_t bits)
+	{
+#ifdef _MSC_VER
+		unsigned long index = 0;
+		_BitScanForward(&index, bits);
+		return uint32_t(index);
+#else
+		return uint32_t(__builtin_ctz(bits));
+#endif
+	}
+
+	ConstSphereSpan Slice(const ConstSphereSpan& span, size_t offset, size_t count)
+	{
+		return ConstSphereSpan{ span.centerX + offset, span.centerY + offset, span.centerZ + offset, span.radius + offset, count };
+	}
+
+	ConstAABBSpan Slice(const ConstAABBSpan& span, size_t offset, size_t count)
+	{
+		return ConstAABBSpan{ span.minX + offset, span.minY + offset, span.minZ + offset, span.maxX + offset, span.maxY + offset, span.maxZ + offset, count };
+	}
+
+	// 一定数ずつビットマスクを求め、立っているビットの番号を詰めて書く
+	template<class Span, class MaskFunction>
+	uint32_t CompactMask(const Span& span, MaskFunction maskFunction, uint32_t* indices)
+	{
+		const size_t kChunk = 256;
+		uint32_t words[kChunk / 32];
+		uint32_t hitCount = 0;
+		for (size_t offset = 0; offset < span.count; offset += kChunk)
+		{
+			const size_t count = std::min(kChunk, span.count - offset);
+			maskFunction(Slice(span, offset, count), words);
+			for (size_t w = 0; w < (count + 31) / 32; ++w)
+			{
+				for (uint32_t bits = words[w]; bits != 0; bits &= bits - 1)
+				{
+					indices[hitCount++] = uint32_t(offset + w * 32 + CountTrailingZeros(bits));
+				}
+			}
+		}
+		return hitCount;
+	}
+}
+
+void MathFunction::IsCollisionMask(const Sphere& sphere, const ConstSphereSpan& spheres, uint32_t* mask)
+{
+	const size_t count = spheres.count;
+	ClearMask(count, mask);
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	{
+		const __m256 cx = _mm256_set1_ps(sphere.center.x), cy = _mm256_set1_ps(sphere.center.y), cz = _mm256_set1_ps(sphere.center.z);
+		const __m256 radius = _mm256_set1_ps(sphere.radius);
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(spheres.centerX + i), cx);
+			__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(spheres.centerY + i), cy);
+			__m256 dz = _mm256_sub_ps(_mm256_loadu_ps(spheres.centerZ + i), cz);
+			__m256 distanceSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+			__m256 radiusSum = _mm256_add_ps(radius, _mm256_loadu_ps(spheres.radius + i));
+			__m256 hit = _mm256_cmp_ps(distanceSq, _mm256_mul_ps(radiusSum, radiusSum), _CMP_LE_OQ);
+			mask[i >> 5] |= uint32_t(_mm256_movemask_ps(hit)) << (i & 31);
+		}
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	{
+		const __m128 cx = _mm_set1_ps(sphere.center.x), cy = _mm_set1_ps(sphere.center.y), cz = _mm_set1_ps(sphere.center.z);
+		const __m128 radius = _mm_set1_ps(sphere.radius);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 dx = _mm_sub_ps(_mm_loadu_ps(spheres.centerX + i), cx);
+			__m128 dy = _mm_sub_ps(_mm_loadu_ps(spheres.centerY + i), cy);
+			__m128 dz = _mm_sub_ps(_mm_loadu_ps(spheres.centerZ + i), cz);
+			__m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			__m128 radiusSum = _mm_add_ps(radius, _mm_loadu_ps(spheres.radius + i));
+			__m128 hit = _mm_cmple_ps(distanceSq, _mm_mul_ps(radiusSum, radiusSum));
+			mask[i >> 5] |= uint32_t(_mm_movemask_ps(hit)) << (i & 31);
+		}
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		if (IsCollision(sphere, Sphere{ { spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i] }, spheres.radius[i] }))
+		{
+			mask[i >> 5] |= 1u << (i & 31);
+		}
+	}
+}
+
+uint32_t MathFunction::IsCollisionIndices(const Sphere& sphere, const ConstSphereSpan& spheres, uint32_t* indices)
+{
+	return CompactMask(spheres, [&](const ConstSphereSpan& chunk, uint32_t* mask) { IsCollisionMask(sphere, chunk, mask); }, indices);
+}
+
+void MathFunction::IsCollisionMask(const Sphere& sphere, const ConstAABBSpan& aabbs, uint32_t* mask)
+{
+	const size_t count = aabbs.count;
+	ClearMask(count, mask);
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	{
+		const __m256 cx = _mm256_set1_ps(sphere.center.x), cy = _mm256_set1_ps(sphere.center.y), cz = _mm256_set1_ps(sphere.center.z);
+		const __m256 radiusSq = _mm256_set1_ps(sphere.radius * sphere.radius);
+		for (; i + 8 <= count; i += 8)
+		{
+			// 最近接点は中心をAABBの範囲に収めた点
+			__m256 dx = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cx, _mm256_loadu_ps(aabbs.minX + i)), _mm256_loadu_ps(aabbs.maxX + i)), cx);
+			__m256 dy = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cy, _mm256_loadu_ps(aabbs.minY + i)), _mm256_loadu_ps(aabbs.maxY + i)), cy);
+			__m256 dz = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cz, _mm256_loadu_ps(aabbs.minZ + i)), _mm256_loadu_ps(aabbs.maxZ + i)), cz);
+			__m256 distanceSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+			__m256 hit = _mm256_cmp_ps(distanceSq, radiusSq, _CMP_LE_OQ);
+			mask[i >> 5] |= uint32_t(_mm256_movemask_ps(hit)) << (i & 31);
+		}
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	{
+		const __m128 cx = _mm_set1_ps(sphere.center.x), cy = _mm_set1_ps(sphere.center.y), cz = _mm_set1_ps(sphere.center.z);
+		const __m128 radiusSq = _mm_set1_ps(sphere.radius * sphere.radius);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 dx = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cx, _mm_loadu_ps(aabbs.minX + i)), _mm_loadu_ps(aabbs.maxX + i)), cx);
+			__m128 dy = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cy, _mm_loadu_ps(aabbs.minY + i)), _mm_loadu_ps(aabbs.maxY + i)), cy);
+			__m128 dz = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cz, _mm_loadu_ps(aabbs.minZ + i)), _mm_loadu_ps(aabbs.maxZ + i)), cz);
+			__m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			__m128 hit = _mm_cmple_ps(distanceSq, radiusSq);
+			mask[i >> 5] |= uint32_t(_mm_movemask_ps(hit)) << (i & 31);
+		}
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		AABB aabb{ { aabbs.minX[i], aabbs.minY[i], aabbs.minZ[i] }, { aabbs.maxX[i], aabbs.maxY[i], aabbs.maxZ[i] } };
+		if (IsCollision(aabb, sphere))
+		{
+			mask[i >> 5] |= 1u << (i & 31);
+		}
+	}
+}
+
+uint32_t MathFunction::IsCollisionIndices(const Sphere& sphere, const ConstAABBSpan& aabbs, uint32_t* indices)
+{
+	return CompactMask(aabbs, [&](const ConstAABBSpan& chunk, uint32_t* mask) { IsCollisionMask(sphere, chunk, mask); }, indices);
+}
+
+void MathFunction::IsCollisionMask(const AABB& aabb, const ConstAABBSpan& aabbs, uint32_t* mask)
+{
+	const size_t count = aabbs.count;
+	ClearMask(count, mask);
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	{
+		const __m256 minX = _mm256_set1_ps(aabb.min.x), minY = _mm256_set1_ps(aabb.min.y), minZ = _mm256_set1_ps(aabb.min.z);
+		const __m256 maxX = _mm256_set1_ps(aabb.max.x), maxY = _mm256_set1_ps(aabb.max.y), maxZ = _mm256_set1_ps(aabb.max.z);
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 hit = _mm256_and_ps(_mm256_cmp_ps(minX, _mm256_loadu_ps(aabbs.maxX + i), _CMP_LE_OQ), _mm256_cmp_ps(maxX, _mm256_loadu_ps(aabbs.minX + i), _CMP_GE_OQ));
+			hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(minY, _mm256_loadu_ps(aabbs.maxY + i), _CMP_LE_OQ), _mm256_cmp_ps(maxY, _mm256_loadu_ps(aabbs.minY + i), _CMP_GE_OQ)));
+			hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(minZ, _mm256_loadu_ps(aabbs.maxZ + i), _CMP_LE_OQ), _mm256_cmp_ps(maxZ, _mm256_loadu_ps(aabbs.minZ + i), _CMP_GE_OQ)));
+			mask[i >> 5] |= uint32_t(_mm256_movemask_ps(hit)) << (i & 31);
+		}
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	{
+		const __m128 minX = _mm_set1_ps(aabb.min.x), minY = _mm_set1_ps(aabb.min.y), minZ = _mm_set1_ps(aabb.min.z);
+		const __m128 maxX = _mm_set1_ps(aabb.max.x), maxY = _mm_set1_ps(aabb.max.y), maxZ = _mm_set1_ps(aabb.max.z);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 hit = _mm_and_ps(_mm_cmple_ps(minX, _mm_loadu_ps(aabbs.maxX + i)), _mm_cmpge_ps(maxX, _mm_loadu_ps(aabbs.minX + i)));
+			hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(minY, _mm_loadu_ps(aabbs.maxY + i)), _mm_cmpge_ps(maxY, _mm_loadu_ps(aabbs.minY + i))));
+			hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(minZ, _mm_loadu_ps(aabbs.maxZ + i)), _mm_cmpge_ps(maxZ, _mm_loadu_ps(aabbs.minZ + i))));
+			mask[i >> 5] |= uint32_t(_mm_movemask_ps(hit)) << (i & 31);
+		}
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		if (IsCollision(aabb, AABB{ { aabbs.minX[i], aabbs.minY[i], aabbs.minZ[i] }, { aabbs.maxX[i], aabbs.maxY[i], aabbs.maxZ[i] } }))
+		{
+			mask[i >> 5] |= 1u << (i & 31);
+		}
+	}
+}
+
+uint32_t MathFunction::IsCollisionIndices(const AABB& aabb, const ConstAABBSpan& aabbs, uint32_t* indices)
+{
+	return CompactMask(aabbs, [&](const ConstAABBSpan& chunk, uint32_t* mask) { IsCollisionMask(aabb, chunk, mask); }, indices);
+}
+
+void MathFunction::IsCollisionMask(const AABB& aabb, const ConstSphereSpan& spheres, uint32_t* mask)
+{
+	const size_t count = spheres.count;
+	ClearMask(count, mask);
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	{
+		const __m256 minX = _mm256_set1_ps(aabb.min.x), minY = _mm256_set1_ps(aabb.min.y), minZ = _mm256_set1_ps(aabb.min.z);
+		const __m256 maxX = _mm256_set1_ps(aabb.max.x), maxY = _mm256_set1_ps(aabb.max.y), maxZ = _mm256_set1_ps(aabb.max.z);
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 cx = _mm256_loadu_ps(spheres.centerX + i), cy = _mm256_loadu_ps(spheres.centerY + i), cz = _mm256_loadu_ps(spheres.centerZ + i);
+			__m256 radius = _mm256_loadu_ps(spheres.radius + i);
+			__m256 dx = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cx, minX), maxX), cx);
+			__m256 dy = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cy, minY), maxY), cy);
+			__m256 dz = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cz, minZ), maxZ), cz);
+			__m256 distanceSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+			__m256 hit = _mm256_cmp_ps(distanceSq, _mm256_mul_ps(radius, radius), _CMP_LE_OQ);
+			mask[i >> 5] |= uint32_t(_mm256_movemask_ps(hit)) << (i & 31);
+		}
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	{
+		const __m128 minX = _mm_set1_ps(aabb.min.x), minY = _mm_set1_ps(aabb.min.y), minZ = _mm_set1_ps(aabb.min.z);
+		const __m128 maxX = _mm_set1_ps(aabb.max.x), maxY = _mm_set1_ps(aabb.max.y), maxZ = _mm_set1_ps(aabb.max.z);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 cx = _mm_loadu_ps(spheres.centerX + i), cy = _mm_loadu_ps(spheres.centerY + i), cz = _mm_loadu_ps(spheres.centerZ + i);
+			__m128 radius = _mm_loadu_ps(spheres.radius + i);
+			__m128 dx = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cx, minX), maxX), cx);
+			__m128 dy = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cy, minY), maxY), cy);
+			__m128 dz = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cz, minZ), maxZ), cz);
+			__m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			__m128 hit = _mm_cmple_ps(distanceSq, _mm_mul_ps(radius, radius));
+			mask[i >> 5] |= uint32_t(_mm_movemask_ps(hit)) << (i & 31);
+		}
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		if (IsCollision(aabb, Sphere{ { spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i] }, spheres.radius[i] }))
+		{
+			mask[i >> 5] |= 1u << (i & 31);
+		}
+	}
+}
+
+uint32_t MathFunction::IsCollisionIndices(const AABB& aabb, const ConstSphereSpan& spheres, uint32_t* indices)
+{
+	return CompactMask(spheres, [&](const ConstSphereSpan& chunk, uint32_t* mask) { IsCollisionMask(aabb, chunk, mask); }, indices);
+}
+
+namespace
+{
+	// スラブ法の本体。mask と、指定があれば全要素の入るときのt（tEnters）を書く
+	void RayQueryKernel(MathFunction& mathFunc, const RayQuery& query, const ConstAABBSpan& aabbs, uint32_t* mask, float* tEnters)
+	{
+		const size_t count = aabbs.count;
+		ClearMask(count, mask);
+		// 符号は全要素で共通なので、近い面と遠い面の配列をここで選ぶ
+		const float* nearX = query.sign[0] ? aabbs.maxX : aabbs.minX;
+		const float* farX = query.sign[0] ? aabbs.minX : aabbs.maxX;
+		const float* nearY = query.sign[1] ? aabbs.maxY : aabbs.minY;
+		const float* farY = query.sign[1] ? aabbs.minY : aabbs.maxY;
+		const float* nearZ = query.sign[2] ? aabbs.maxZ : aabbs.minZ;
+		const float* farZ = query.sign[2] ? aabbs.minZ : aabbs.maxZ;
+		size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+		{
+			const __m256 ox = _mm256_set1_ps(query.origin.x), oy = _mm256_set1_ps(query.origin.y), oz = _mm256_set1_ps(query.origin.z);
+			const __m256 ix = _mm256_set1_ps(query.inverseDiff.x), iy = _mm256_set1_ps(query.inverseDiff.y), iz = _mm256_set1_ps(query.inverseDiff.z);
+			const __m256 tMin = _mm256_set1_ps(query.tMin), tMax = _mm256_set1_ps(query.tMax);
+			for (; i + 8 <= count; i += 8)
+			{
+				// max/minは片方がNaNなら2番目の引数を返すので、NaNの軸は無視される
+				__m256 enter = _mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(nearX + i), ox), ix), tMin);
+				enter = _mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(nearY + i), oy), iy), enter);
+				enter = _mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(nearZ + i), oz), iz), enter);
+				__m256 exit = _mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(farX + i), ox), ix), tMax);
+				exit = _mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(farY + i), oy), iy), exit);
+				exit = _mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(farZ + i), oz), iz), exit);
+				mask[i >> 5] |= uint32_t(_mm256_movemask_ps(_mm256_cmp_ps(enter, exit, _CMP_LE_OQ))) << (i & 31);
+				if (tEnters)
+				{
+					_mm256_storeu_ps(tEnters + i, enter);
+				}
+			}
+		}
+#endif
+#if defined(MATH_SIMD_SSE2)
+		{
+			const __m128 ox = _mm_set1_ps(query.origin.x), oy = _mm_set1_ps(query.origin.y), oz = _mm_set1_ps(query.origin.z);
+			const __m128 ix = _mm_set1_ps(query.inverseDiff.x), iy = _mm_set1_ps(query.inverseDiff.y), iz = _mm_set1_ps(query.inverseDiff.z);
+			const __m128 tMin = _mm_set1_ps(query.tMin), tMax = _mm_set1_ps(query.tMax);
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 enter = _mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearX + i), ox), ix), tMin);
+				enter = _mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearY + i), oy), iy), enter);
+				enter = _mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearZ + i), oz), iz), enter);
+				__m128 exit = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farX + i), ox), ix), tMax);
+				exit = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farY + i), oy), iy), exit);
+				exit = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farZ + i), oz), iz), exit);
+				mask[i >> 5] |= uint32_t(_mm_movemask_ps(_mm_cmple_ps(enter, exit))) << (i & 31);
+				if (tEnters)
+				{
+					_mm_storeu_ps(tEnters + i, enter);
+				}
+			}
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			AABB aabb{ { aabbs.minX[i], aabbs.minY[i], aabbs.minZ[i] }, { aabbs.maxX[i], aabbs.maxY[i], aabbs.maxZ[i] } };
+			float enter = 0.0f;
+			if (mathFunc.IsCollision(aabb, query, &enter))
+			{
+				mask[i >> 5] |= 1u << (i & 31);
+			}
+			if (tEnters)
+			{
+				tEnters[i] = enter;
+			}
+		}
+	}
+}
+
+void MathFunction::IsCollisionMask(const RayQuery& query, const ConstAABBSpan& aabbs, uint32_t* mask)
+{
+	RayQueryKernel(*this, query, aabbs, mask, nullptr);
+}
+
+uint32_t MathFunction::IsCollisionIndices(const RayQuery& query, const ConstAABBSpan& aabbs, uint32_t* indices, float* tEnters)
+{
+	if (!tEnters)
+	{
+		return CompactMask(aabbs, [&](const ConstAABBSpan& chunk, uint32_t* mask) { RayQueryKernel(*this, query, chunk, mask, nullptr); }, indices);
+	}
+
+	// tも詰めるので、一定数ずつ全要素のtを求めてから衝突したものだけ書く
+	const size_t kChunk = 256;
+	uint32_t words[kChunk / 32];
+	float chunkTEnters[kChunk];
+	uint32_t hitCount = 0;
+	for (size_t offset = 0; offset < aabbs.count; offset += kChunk)
+	{
+		const size_t count = std::min(kChunk, aabbs.count - offset);
+		RayQueryKernel(*this, query, Slice(aabbs, offset, count), words, chunkTEnters);
+		for (size_t w = 0; w < (count + 31) / 32; ++w)
+		{
+			for (uint32_t bits = words[w]; bits != 0; bits &= bits - 1)
+			{
+				uint32_t local = uint32_t(w * 32 + CountTrailingZeros(bits));
+				tEnters[hitCount] = chunkTEnters[local];
+				indices[hitCount++] = uint32_t(offset + local);
+			}
+		}
+	}
+	return hitCount;
+}
+
+void MathFunction::IsCollisionMask(const Frustum& frustum, const ConstSphereSpan& spheres, uint32_t* mask)
+{
+	const size_t count = spheres.count;
+	ClearMask(count, mask);
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 cx = _mm256_loadu_ps(spheres.centerX + i), cy = _mm256_loadu_ps(spheres.centerY + i), cz = _mm256_loadu_ps(spheres.centerZ + i);
+		__m256 negativeRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(spheres.radius + i));
+		// どれかの平面の裏側に半径より離れていれば外。外のビットを集めて最後に反転する
+		__m256 outside = _mm256_setzero_ps();
+		for (const Plane& plane : frustum.planes)
+		{
+			__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.normal.x), cx), _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), cy)), _mm256_mul_ps(_mm256_set1_ps(plane.normal.z), cz));
+			distance = _mm256_sub_ps(distance, _mm256_set1_ps(plane.distance));
+			outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, negativeRadius, _CMP_LT_OQ));
+		}
+		mask[i >> 5] |= (~uint32_t(_mm256_movemask_ps(outside)) & 0xFFu) << (i & 31);
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 cx = _mm_loadu_ps(spheres.centerX + i), cy = _mm_loadu_ps(spheres.centerY + i), cz = _mm_loadu_ps(spheres.centerZ + i);
+		__m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(spheres.radius + i));
+		__m128 outside = _mm_setzero_ps();
+		for (const Plane& plane : frustum.planes)
+		{
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.normal.x), cx), _mm_mul_ps(_mm_set1_ps(plane.normal.y), cy)), _mm_mul_ps(_mm_set1_ps(plane.normal.z), cz));
+			distance = _mm_sub_ps(distance, _mm_set1_ps(plane.distance));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeRadius));
+		}
+		mask[i >> 5] |= (~uint32_t(_mm_movemask_ps(outside)) & 0xFu) << (i & 31);
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		if (IsCollision(frustum, Sphere{ { spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i] }, spheres.radius[i] }))
+		{
+			mask[i >> 5] |= 1u << (i & 31);
+		}
+	}
+}
+
+uint32_t MathFunction::IsCollisionIndices(const Frustum& frustum, const ConstSphereSpan& spheres, uint32_t* indices)
+{
+	return CompactMask(spheres, [&](const ConstSphereSpan& chunk, uint32_t* mask) { IsCollisionMask(frustum, chunk, mask); }, indices);
+}
+
+void MathFunction::IsCollisionMask(const Frustum& frustum, const ConstAABBSpan& aabbs, uint32_t* mask)
+{
+	const size_t count = aabbs.count;
+	ClearMask(count, mask);
+	// 法線の絶対値（AABBの半径を法線方向に投影するのに使う）は全要素で共通
+	Vector3 absNormals[6];
+	for (int p = 0; p < 6; ++p)
+	{
+		const Vector3& normal = frustum.planes[p].normal;
+		absNormals[p] = { std::fabs(normal.x), std::fabs(normal.y), std::fabs(normal.z) };
+	}
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	{
+		const __m256 half = _mm256_set1_ps(0.5f);
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 minX = _mm256_loadu_ps(aabbs.minX + i), minY = _mm256_loadu_ps(aabbs.minY + i), minZ = _mm256_loadu_ps(aabbs.minZ + i);
+			__m256 maxX = _mm256_loadu_ps(aabbs.maxX + i), maxY = _mm256_loadu_ps(aabbs.maxY + i), maxZ = _mm256_loadu_ps(aabbs.maxZ + i);
+			__m256 cx = _mm256_mul_ps(half, _mm256_add_ps(minX, maxX)), cy = _mm256_mul_ps(half, _mm256_add_ps(minY, maxY)), cz = _mm256_mul_ps(half, _mm256_add_ps(minZ, maxZ));
+			__m256 ex = _mm256_mul_ps(half, _mm256_sub_ps(maxX, minX)), ey = _mm256_mul_ps(half, _mm256_sub_ps(maxY, minY)), ez = _mm256_mul_ps(half, _mm256_sub_ps(maxZ, minZ));
+			__m256 outside = _mm256_setzero_ps();
+			for (int p = 0; p < 6; ++p)
+			{
+				const Plane& plane = frustum.planes[p];
+				__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.normal.x), cx), _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), cy)), _mm256_mul_ps(_mm256_set1_ps(plane.normal.z), cz));
+				distance = _mm256_sub_ps(distance, _mm256_set1_ps(plane.distance));
+				__m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ex, _mm256_set1_ps(absNormals[p].x)), _mm256_mul_ps(ey, _mm256_set1_ps(absNormals[p].y))), _mm256_mul_ps(ez, _mm256_set1_ps(absNormals[p].z)));
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, _mm256_sub_ps(_mm256_setzero_ps(), radius), _CMP_LT_OQ));
+			}
+			mask[i >> 5] |= (~uint32_t(_mm256_movemask_ps(outside)) & 0xFFu) << (i & 31);
+		}
+	}
+#endif
+#if defined(MATH_SIMD_SSE2)
+	{
+		const __m128 half = _mm_set1_ps(0.5f);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 minX = _mm_loadu_ps(aabbs.minX + i), minY = _mm_loadu_ps(aabbs.minY + i), minZ = _mm_loadu_ps(aabbs.minZ + i);
+			__m128 maxX = _mm_loadu_ps(aabbs.maxX + i), maxY = _mm_loadu_ps(aabbs.maxY + i), maxZ = _mm_loadu_ps(aabbs.maxZ + i);
+			__m128 cx = _mm_mul_ps(half, _mm_add_ps(minX, maxX)), cy = _mm_mul_ps(half, _mm_add_ps(minY, maxY)), cz = _mm_mul_ps(half, _mm_add_ps(minZ, maxZ));
+			__m128 ex = _mm_mul_ps(half, _mm_sub_ps(maxX, minX)), ey = _mm_mul_ps(half, _mm_sub_ps(maxY, minY)), ez = _mm_mul_ps(half, _mm_sub_ps(maxZ, minZ));
+			__m128 outside = _mm_setzero_ps();
+			for (int p = 0; p < 6; ++p)
+			{
+				const Plane& plane = frustum.planes[p];
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.normal.x), cx), _mm_mul_ps(_mm_set1_ps(plane.normal.y), cy)), _mm_mul_ps(_mm_set1_ps(plane.normal.z), cz));
+				distance = _mm_sub_ps(distance, _mm_set1_ps(plane.distance));
+				__m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(absNormals[p].x)), _mm_mul_ps(ey, _mm_set1_ps(absNormals[p].y))), _mm_mul_ps(ez, _mm_set1_ps(absNormals[p].z)));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_sub_ps(_mm_setzero_ps(), radius)));
+			}
+			mask[i >> 5] |= (~uint32_t(_mm_movemask_ps(outside)) & 0xFu) << (i & 31);
+		}
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		if (IsCollision(frustum, AABB{ { aabbs.minX[i], aabbs.minY[i], aabbs.minZ[i] }, { aabbs.maxX[i], aabbs.maxY[i], aabbs.maxZ[i] } }))
+		{
+			mask[i >> 5] |= 1u << (i & 31);
+		}
+	}
+}
+
+uint32_t MathFunction::IsCollisionIndices(const Frustum& frustum, const ConstAABBSpan& aabbs, uint32_t* indices)
+{
+	return CompactMask(aabbs, [&](const ConstAABBSpan& chunk, uint32_t* mask) { IsCollisionMask(frustum, chunk, mask); }, indices);
+}
@@ -0,0 +1,51 @@
+#include "MeshRaycaster.h"
+#include <algorithm>
+#include <assert.h>
+
+void MeshRaycaster::Build(const Triangle* triangles, uint32_t count)
+{
+	triangles_.assign(triangles, triangles + count);
+	std::vector<AABB> bounds(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const Vector3* vertices = triangles_[i].vertices;
+		bounds[i].min = { std::min({ vertices[0].x, vertices[1].x, vertices[2].x }), std::min({ vertices[0].y, vertices[1].y, vertices[2].y }), std::min({ vertices[0].z, vertices[1].z, vertices[2].z }) };
+		bounds[i].max = { std::max({ vertices[0].x, vertices[1].x, vertices[2].x }), std::max({ vertices[0].y, vertices[1].y, vertices[2].y }), std::max({ vertices[0].z, vertices[1].z, vertices[2].z }) };
+	}
+	bvh_.Build(bounds.data(), count);
+}
+
+template<typename Shape>
+bool MeshRaycaster::RaycastShape(const Shape& shape, MeshRaycastHit* hit) const
+{
+	assert(hit);
+	TriangleHit closest{};
+	uint32_t hitIndex = 0;
+	bool isHit = bvh_.Raycast(mathFunc_.MakeRayQuery(shape), [&](uint32_t index, float tMax, float* t)
+		{
+			TriangleHit candidate{};
+			if (!mathFunc_.IsCollision(triangles_[index], shape, &candidate) || candidate.t > tMax)
+			{
+				return false;
+			}
+			closest = candidate;
+			*t = candidate.t;
+			return true;
+		}, &hitIndex);
+	if (isHit)
+	{
+		hit->triangleIndex = hitIndex;
+		hit->hit = closest;
+	}
+	return isHit;
+}
+
+bool MeshRaycaster::Raycast(const Segment& segment, MeshRaycastHit* hit) const
+{
+	return RaycastShape(segment, hit);
+}
+
+bool MeshRaycaster::Raycast(const Ray& ray, MeshRaycastHit* hit) const
+{
+	return RaycastShape(ray, hit);
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "BVH.h"
+#include "MathFunction.h"
+#include "Ray.h"
+#include "Segment.h"
+#include "Triangle.h"
+#include "TriangleHit.h"
+#include <cstdint>
+#include <vector>
+
+//メッシュとのレイキャストの結果
+struct MeshRaycastHit final
+{
+	uint32_t triangleIndex;	//!< 当たった三角形の番号
+	TriangleHit hit;		//!< 交点のtと重心座標
+};
+
+/// <summary>
+/// 三角形の配列に対するレイキャスト（三角形のAABBでBVHを作り、最も近い交点を求める）
+/// </summary>
+class MeshRaycaster
+{
+public:
+	/// <summary>
+	/// 三角形を登録してBVHを作る（三角形の番号は配列の添え字）
+	/// </summary>
+	/// <param name="triangles"></param>
+	/// <param name="count"></param>
+	void Build(const Triangle* triangles, uint32_t count);
+
+	/// <summary>
+	/// 線分が最初に当たる三角形を求める
+	/// </summary>
+	/// <param name="segment"></param>
+	/// <param name="hit">当たった場合の結果</param>
+	/// <returns>当たればtrue</returns>
+	bool Raycast(const Segment& segment, MeshRaycastHit* hit) const;
+	/// <summary>
+	/// 半直線が最初に当たる三角形を求める
+	/// </summary>
+	/// <param name="ray"></param>
+	/// <param name="hit">当たった場合の結果</param>
+	/// <returns>当たればtrue</returns>
+	bool Raycast(const Ray& ray, MeshRaycastHit* hit) const;
+
+	/// <summary>
+	/// 三角形の数
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetTriangleCount() const { return uint32_t(triangles_.size()); }
+	/// <summary>
+	/// 三角形
+	/// </summary>
+	/// <param name="index"></param>
+	/// <returns></returns>
+	const Triangle& GetTriangle(uint32_t index) const { return triangles_[index]; }
+
+private:
+	/// <summary>
+	/// 線分・半直線で共通のレイキャスト
+	/// </summary>
+	/// <param name="shape"></param>
+	/// <param name="hit"></param>
+	/// <returns></returns>
+	template<typename Shape>
+	bool RaycastShape(const Shape& shape, MeshRaycastHit* hit) const;
+
+	std::vector<Triangle> triangles_;	//三角形
+	BVH bvh_;							//三角形のAABBのBVH
+	mutable MathFunction mathFunc_;		//レイと三角形の判定
+};
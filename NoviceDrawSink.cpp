@@ -0,0 +1,12 @@
+#include "NoviceDrawSink.h"
+#include "Novice.h"
+
+void NoviceDrawSink::DrawLine(int x1, int y1, int x2, int y2, uint32_t color)
+{
+	Novice::DrawLine(x1, y1, x2, y2, color);
+}
+
+void NoviceDrawSink::DrawTriangle(int x1, int y1, int x2, int y2, int x3, int y3, uint32_t color)
+{
+	Novice::DrawTriangle(x1, y1, x2, y2, x3, y3, color, kFillModeWireFrame);
+}
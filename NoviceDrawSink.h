@@ -0,0 +1,12 @@
+#pragma once
+#include "DrawSink.h"
+
+/// <summary>
+/// Noviceにそのまま描画する出力先（Windows/DirectX専用）
+/// </summary>
+class NoviceDrawSink : public DrawSink
+{
+public:
+	void DrawLine(int x1, int y1, int x2, int y2, uint32_t color) override;
+	void DrawTriangle(int x1, int y1, int x2, int y2, int x3, int y3, uint32_t color) override;
+};
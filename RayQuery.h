@@ -0,0 +1,12 @@
+#pragma once
+#include "Vector3.h"
+
+//半直線・線分の問い合わせ（方向の逆数と符号を前計算して、多数のAABBとの判定で使い回す）
+struct RayQuery final
+{
+	Vector3 origin;				//!<始点
+	Vector3 inverseDiff;		//!<差分の逆数（成分が0なら±無限大）
+	int sign[3];				//!<差分の逆数が負なら1（x,y,z）
+	float tMin;					//!<tの下限（0）
+	float tMax;					//!<tの上限（線分は1、半直線は無限大）
+};
@@ -0,0 +1,10 @@
+#pragma once
+#include "Frustum.h"
+#include "Matrix4x4.h"
+
+//ワールド座標 -> スクリーン座標の変換（フレームごとに1回だけ作る）
+struct ScreenTransform final
+{
+	Matrix4x4 matrix;	//!< ビュープロジェクション行列×ビューポート行列
+	Frustum frustum;	//!< 視錐台（描画前のカリング用。0初期化のままなら何も間引かない）
+};
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+
+//SoA形式の球の配列（読み取り専用）
+struct ConstSphereSpan final
+{
+	const float* centerX;	//!< 中心のx成分の配列
+	const float* centerY;	//!< 中心のy成分の配列
+	const float* centerZ;	//!< 中心のz成分の配列
+	const float* radius;	//!< 半径の配列
+	size_t count;			//!< 要素数
+};
+
+//SoA形式のAABBの配列（読み取り専用）
+struct ConstAABBSpan final
+{
+	const float* minX;		//!< 最小値のx成分の配列
+	const float* minY;		//!< 最小値のy成分の配列
+	const float* minZ;		//!< 最小値のz成分の配列
+	const float* maxX;		//!< 最大値のx成分の配列
+	const float* maxY;		//!< 最大値のy成分の配列
+	const float* maxZ;		//!< 最大値のz成分の配列
+	size_t count;			//!< 要素数
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+// 利用できるSIMD命令セットの判定
+// MSVCのx64は常にSSE2を持つ。AVX2は /arch:AVX2 または -mavx2 指定時のみ有効
+#if defined(__AVX2__)
+#define MATH_SIMD_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_SIMD_SSE2 1
+#endif
+
+#if defined(MATH_SIMD_AVX2) || defined(MATH_SIMD_SSE2)
+#include <immintrin.h>
+#endif
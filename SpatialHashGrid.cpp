@@ -0,0 +1,145 @@
+#include "SpatialHashGrid.h"
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+
+void SpatialHashGrid::Build(const Sphere* spheres, uint32_t count, float cellSize)
+{
+	spheres_.assign(spheres, spheres + count);
+
+	maxRadius_ = 0.0f;
+	for (const Sphere& sphere : spheres_)
+	{
+		maxRadius_ = std::max(maxRadius_, sphere.radius);
+	}
+	// 既定のセルは最大直径の2倍。周囲27セルで足りる範囲で、1セルあたりの物体数とハッシュの衝突のつり合いがよい
+	cellSize_ = cellSize > 0.0f ? cellSize : std::max(maxRadius_ * 4.0f, 1e-6f);
+	inverseCellSize_ = 1.0f / cellSize_;
+
+	// バケット数は物体数の2倍以上の2のべき乗
+	uint32_t bucketCount = 1;
+	while (bucketCount < count * 2)
+	{
+		bucketCount <<= 1;
+	}
+	bucketMask_ = bucketCount - 1;
+
+	// 計数ソート：数える → 累積して先頭を求める → 詰める
+	bucketStarts_.assign(size_t(bucketCount) + 1, 0);
+	objectBuckets_.resize(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const Vector3& center = spheres_[i].center;
+		uint32_t bucket = GetBucket(GetCell(center.x), GetCell(center.y), GetCell(center.z));
+		objectBuckets_[i] = bucket;
+		bucketStarts_[bucket + 1]++;
+	}
+	for (uint32_t b = 0; b < bucketCount; ++b)
+	{
+		bucketStarts_[b + 1] += bucketStarts_[b];
+	}
+	sortedIndices_.resize(count);
+	sortedSpheres_.resize(count);
+	sortedCells_.resize(count);
+	std::vector<uint32_t> cursors(bucketStarts_.begin(), bucketStarts_.end() - 1);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const Vector3& center = spheres_[i].center;
+		uint32_t k = cursors[objectBuckets_[i]]++;
+		sortedIndices_[k] = i;
+		sortedSpheres_[k] = spheres_[i];
+		sortedCells_[k] = Cell{ GetCell(center.x), GetCell(center.y), GetCell(center.z) };
+	}
+}
+
+template<class Function>
+void SpatialHashGrid::ForEachInCells(const Vector3& min, const Vector3& max, Function function) const
+{
+	const int32_t minX = GetCell(min.x), minY = GetCell(min.y), minZ = GetCell(min.z);
+	const int32_t maxX = GetCell(max.x), maxY = GetCell(max.y), maxZ = GetCell(max.z);
+	const int64_t cellCount = int64_t(maxX - minX + 1) * (maxY - minY + 1) * (maxZ - minZ + 1);
+	if (cellCount > int64_t(sortedIndices_.size()))
+	{
+		// セルの方が物体より多ければ全ての物体を見た方が早い
+		for (uint32_t k = 0; k < sortedIndices_.size(); ++k)
+		{
+			const Cell& cell = sortedCells_[k];
+			if (minX <= cell.x && cell.x <= maxX && minY <= cell.y && cell.y <= maxY && minZ <= cell.z && cell.z <= maxZ)
+			{
+				function(k);
+			}
+		}
+		return;
+	}
+
+	for (int32_t z = minZ; z <= maxZ; ++z)
+	{
+		for (int32_t y = minY; y <= maxY; ++y)
+		{
+			for (int32_t x = minX; x <= maxX; ++x)
+			{
+				uint32_t bucket = GetBucket(x, y, z);
+				for (uint32_t k = bucketStarts_[bucket]; k < bucketStarts_[bucket + 1]; ++k)
+				{
+					// 物体はちょうど1つのセルに属するので、同じバケットを2回見ても重複しない
+					const Cell& cell = sortedCells_[k];
+					if (cell.x == x && cell.y == y && cell.z == z)
+					{
+						function(k);
+					}
+				}
+			}
+		}
+	}
+}
+
+void SpatialHashGrid::QuerySphere(const Sphere& sphere, std::vector<uint32_t>& result) const
+{
+	result.clear();
+
+	// 中心が入りうる範囲（問い合わせの半径 + 最大半径）のセルを見る
+	const float reach = sphere.radius + maxRadius_;
+	ForEachInCells({ sphere.center.x - reach, sphere.center.y - reach, sphere.center.z - reach },
+		{ sphere.center.x + reach, sphere.center.y + reach, sphere.center.z + reach }, [&](uint32_t k)
+		{
+			if (mathFunc_.IsCollision(sphere, sortedSpheres_[k]))
+			{
+				result.push_back(sortedIndices_[k]);
+			}
+		});
+	std::sort(result.begin(), result.end());
+}
+
+void SpatialHashGrid::QueryOverlapPairs(std::vector<CollisionPair>& pairs) const
+{
+	pairs.clear();
+	const uint32_t count = GetCount();
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		// 重なる相手の中心は（自分の半径 + 最大半径）以内にある
+		const Sphere& sphere = spheres_[i];
+		const float reach = sphere.radius + maxRadius_;
+		const size_t firstPair = pairs.size();
+		ForEachInCells({ sphere.center.x - reach, sphere.center.y - reach, sphere.center.z - reach },
+			{ sphere.center.x + reach, sphere.center.y + reach, sphere.center.z + reach }, [&](uint32_t k)
+			{
+				// 各組を1回だけ判定する
+				uint32_t other = sortedIndices_[k];
+				if (other > i && mathFunc_.IsCollision(sphere, sortedSpheres_[k]))
+				{
+					pairs.push_back(CollisionPair{ i, other });
+				}
+			});
+		std::sort(pairs.begin() + firstPair, pairs.end(), [](const CollisionPair& a, const CollisionPair& b) { return a.second < b.second; });
+	}
+}
+
+uint32_t SpatialHashGrid::GetBucket(int32_t x, int32_t y, int32_t z) const
+{
+	return (uint32_t(x) * 73856093u ^ uint32_t(y) * 19349663u ^ uint32_t(z) * 83492791u) & bucketMask_;
+}
+
+int32_t SpatialHashGrid::GetCell(float value) const
+{
+	return int32_t(std::floor(value * inverseCellSize_));
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "CollisionPair.h"
+#include "MathFunction.h"
+#include "Sphereh.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 球用の一様グリッド（中心が入るセルの整数座標をハッシュして登録する）。
+/// 毎フレームO(N)の計数ソートで平坦な配列に作り直すので、ノードの確保はしない
+/// </summary>
+class SpatialHashGrid
+{
+public:
+	/// <summary>
+	/// グリッドを作り直す（物体の番号は配列の添え字）
+	/// </summary>
+	/// <param name="spheres"></param>
+	/// <param name="count"></param>
+	/// <param name="cellSize">セルの一辺。0以下なら最大直径の2倍</param>
+	void Build(const Sphere* spheres, uint32_t count, float cellSize = 0.0f);
+
+	/// <summary>
+	/// 球と重なる物体を求める
+	/// </summary>
+	/// <param name="sphere"></param>
+	/// <param name="result">物体の番号（上書き・昇順）</param>
+	void QuerySphere(const Sphere& sphere, std::vector<uint32_t>& result) const;
+	/// <summary>
+	/// 重なっている物体の組を全て求める
+	/// </summary>
+	/// <param name="pairs">結果（上書き・昇順）</param>
+	void QueryOverlapPairs(std::vector<CollisionPair>& pairs) const;
+
+	/// <summary>
+	/// 物体の数
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetCount() const { return uint32_t(spheres_.size()); }
+	/// <summary>
+	/// セルの一辺
+	/// </summary>
+	/// <returns></returns>
+	float GetCellSize() const { return cellSize_; }
+
+private:
+	/// <summary>
+	/// セル座標からバケット番号を求める
+	/// </summary>
+	/// <param name="x"></param>
+	/// <param name="y"></param>
+	/// <param name="z"></param>
+	/// <returns></returns>
+	uint32_t GetBucket(int32_t x, int32_t y, int32_t z) const;
+	/// <summary>
+	/// 座標が入るセルの整数座標
+	/// </summary>
+	/// <param name="value"></param>
+	/// <returns></returns>
+	int32_t GetCell(float value) const;
+	/// <summary>
+	/// 範囲内のセルに中心がある物体を列挙する。ハッシュが衝突した別のセルの物体は除く
+	/// </summary>
+	/// <param name="min"></param>
+	/// <param name="max"></param>
+	/// <param name="function">物体の番号を受け取る</param>
+	template<class Function>
+	void ForEachInCells(const Vector3& min, const Vector3& max, Function function) const;
+
+	//セルの整数座標
+	struct Cell final
+	{
+		int32_t x;
+		int32_t y;
+		int32_t z;
+	};
+
+	std::vector<Sphere> spheres_;			//物体
+	std::vector<uint32_t> bucketStarts_;	//バケットごとの先頭（sortedIndices_の位置、要素数はバケット数+1）
+	std::vector<uint32_t> sortedIndices_;	//バケット順に並べた物体の番号
+	std::vector<Sphere> sortedSpheres_;		//バケット順に並べた物体（判定時に連続して読むため）
+	std::vector<Cell> sortedCells_;			//バケット順に並べた物体のセル
+	std::vector<uint32_t> objectBuckets_;	//物体が入っているバケット
+	uint32_t bucketMask_ = 0;				//バケット数-1（バケット数は2のべき乗）
+	float cellSize_ = 1.0f;					//セルの一辺
+	float inverseCellSize_ = 1.0f;			//セルの一辺の逆数
+	float maxRadius_ = 0.0f;				//最大半径
+	mutable MathFunction mathFunc_;			//セルに入っている形状との衝突判定
+};
@@ -0,0 +1,63 @@
+#include "SphereLattice.h"
+#include <assert.h>
+#include <cmath>
+#ifdef _MSC_VER
+#include <corecrt_math_defines.h>
+#endif
+#include <map>
+#include <memory>
+#include <mutex>
+
+const SphereLattice& SphereLattice::Get(uint32_t subdivision)
+{
+	static std::mutex mutex;
+	static std::map<uint32_t, std::unique_ptr<SphereLattice>> lattices;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	std::unique_ptr<SphereLattice>& lattice = lattices[subdivision];
+	if (!lattice)
+	{
+		lattice = std::make_unique<SphereLattice>(subdivision);
+	}
+	return *lattice;
+}
+
+SphereLattice::SphereLattice(uint32_t subdivision)
+	: subdivision_(subdivision)
+{
+	assert(subdivision > 0);
+	const float kLatStep = (float)M_PI / subdivision;				//緯度のステップ
+	const float kLonStep = 2.0f * (float)M_PI / subdivision;		//経度のステップ
+
+	// 経度ごとのcos/sinは全ての緯度で共通
+	std::vector<float> cosLon(subdivision), sinLon(subdivision);
+	for (uint32_t lonIndex = 0; lonIndex < subdivision; ++lonIndex)
+	{
+		float lon = lonIndex * kLonStep;
+		cosLon[lonIndex] = std::cos(lon);
+		sinLon[lonIndex] = std::sin(lon);
+	}
+
+	vertices_.resize(size_t(subdivision + 1) * subdivision);
+	for (uint32_t latIndex = 0; latIndex <= subdivision; ++latIndex)
+	{
+		float lat = -0.5f * (float)M_PI + latIndex * kLatStep;	//現在の緯度
+		float cosLat = std::cos(lat);
+		float sinLat = std::sin(lat);
+		for (uint32_t lonIndex = 0; lonIndex < subdivision; ++lonIndex)
+		{
+			vertices_[GetIndex(latIndex, lonIndex)] = { cosLat * cosLon[lonIndex], sinLat, cosLat * sinLon[lonIndex] };
+		}
+	}
+
+	// マスごとに、次の緯度への線と次の経度への線
+	lineIndices_.reserve(size_t(subdivision) * subdivision * 4);
+	for (uint32_t latIndex = 0; latIndex < subdivision; ++latIndex)
+	{
+		for (uint32_t lonIndex = 0; lonIndex < subdivision; ++lonIndex)
+		{
+			const uint32_t pointA = GetIndex(latIndex, lonIndex);
+			lineIndices_.insert(lineIndices_.end(), { pointA, GetIndex(latIndex + 1, lonIndex), pointA, GetIndex(latIndex, lonIndex + 1) });
+		}
+	}
+}
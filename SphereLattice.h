@@ -0,0 +1,58 @@
+#pragma once
+#include "LineList.h"
+#include "Vector3.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 単位球の緯度経度格子（分割数ごとに1回だけ計算して使い回す）
+/// </summary>
+class SphereLattice
+{
+public:
+	/// <summary>
+	/// 分割数に対応する格子を取得（初回のみ計算する）
+	/// </summary>
+	/// <param name="subdivision">分割数</param>
+	/// <returns></returns>
+	static const SphereLattice& Get(uint32_t subdivision);
+
+	/// <summary>
+	/// 格子を計算
+	/// </summary>
+	/// <param name="subdivision">分割数</param>
+	explicit SphereLattice(uint32_t subdivision);
+
+	/// <summary>
+	/// 分割数
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetSubdivision() const { return subdivision_; }
+	/// <summary>
+	/// 頂点数（緯度方向 subdivision+1 × 経度方向 subdivision）
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetVertexCount() const { return uint32_t(vertices_.size()); }
+	/// <summary>
+	/// 単位球上の頂点
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<Vector3>& GetVertices() const { return vertices_; }
+	/// <summary>
+	/// 格子の線（マスごとに、次の緯度への線と次の経度への線の順）
+	/// </summary>
+	/// <returns></returns>
+	LineList GetLineList() const { return LineList{ vertices_.data(), GetVertexCount(), lineIndices_.data(), uint32_t(lineIndices_.size() / 2) }; }
+	/// <summary>
+	/// 緯度・経度のインデックスから頂点番号を求める（経度は一周すると0に戻る）
+	/// </summary>
+	/// <param name="latIndex">0～subdivision</param>
+	/// <param name="lonIndex">0～subdivision</param>
+	/// <returns></returns>
+	uint32_t GetIndex(uint32_t latIndex, uint32_t lonIndex) const { return latIndex * subdivision_ + lonIndex % subdivision_; }
+
+private:
+	uint32_t subdivision_;				//分割数
+	std::vector<Vector3> vertices_;		//単位球上の頂点
+	std::vector<uint32_t> lineIndices_;	//線の両端の頂点番号
+};
@@ -0,0 +1,159 @@
+#include "SweepAndPrune.h"
+#include <algorithm>
+#include <assert.h>
+
+namespace
+{
+	uint64_t MakeKey(uint32_t a, uint32_t b)
+	{
+		return a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+	}
+
+	CollisionPair MakePair(uint64_t key)
+	{
+		return CollisionPair{ uint32_t(key >> 32), uint32_t(key) };
+	}
+
+	bool LessPair(const CollisionPair& a, const CollisionPair& b)
+	{
+		return a.first != b.first ? a.first < b.first : a.second < b.second;
+	}
+
+	float GetAxis(const Vector3& v, int axis)
+	{
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+}
+
+void SweepAndPrune::Build(const AABB* aabbs, uint32_t count)
+{
+	aabbs_.assign(aabbs, aabbs + count);
+	pairs_.clear();
+	swapCount_ = 0;
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		std::vector<Endpoint>& endpoints = endpoints_[axis];
+		endpoints.resize(size_t(count) * 2);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			endpoints[i * 2].data = i << 1;
+			endpoints[i * 2 + 1].data = i << 1 | 1;
+		}
+		RefreshValues(axis);
+		std::sort(endpoints.begin(), endpoints.end(), [](const Endpoint& a, const Endpoint& b)
+			{
+				return a.value != b.value ? a.value < b.value : (a.data & 1) < (b.data & 1);
+			});
+	}
+
+	// x軸を掃引し、区間が重なっている物体同士だけを判定する
+	std::vector<uint32_t> active;
+	std::vector<uint32_t> activeSlot(count);
+	for (const Endpoint& endpoint : endpoints_[0])
+	{
+		uint32_t index = endpoint.data >> 1;
+		if ((endpoint.data & 1) == 0)
+		{
+			for (uint32_t other : active)
+			{
+				if (mathFunc_.IsCollision(aabbs_[index], aabbs_[other]))
+				{
+					pairs_.insert(MakeKey(index, other));
+				}
+			}
+			activeSlot[index] = uint32_t(active.size());
+			active.push_back(index);
+		}
+		else
+		{
+			// 末尾と入れ替えて取り除く
+			uint32_t slot = activeSlot[index];
+			active[slot] = active.back();
+			activeSlot[active[slot]] = slot;
+			active.pop_back();
+		}
+	}
+}
+
+void SweepAndPrune::SetAABB(uint32_t index, const AABB& aabb)
+{
+	assert(index < aabbs_.size());
+	aabbs_[index] = aabb;
+}
+
+void SweepAndPrune::Update(std::vector<CollisionPair>& added, std::vector<CollisionPair>& removed)
+{
+	added.clear();
+	removed.clear();
+	swapCount_ = 0;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		RefreshValues(axis);
+		SortAxis(axis, added, removed);
+	}
+	std::sort(added.begin(), added.end(), LessPair);
+	std::sort(removed.begin(), removed.end(), LessPair);
+}
+
+void SweepAndPrune::GetPairs(std::vector<CollisionPair>& pairs) const
+{
+	pairs.clear();
+	pairs.reserve(pairs_.size());
+	for (uint64_t key : pairs_)
+	{
+		pairs.push_back(MakePair(key));
+	}
+	std::sort(pairs.begin(), pairs.end(), LessPair);
+}
+
+void SweepAndPrune::RefreshValues(int axis)
+{
+	for (Endpoint& endpoint : endpoints_[axis])
+	{
+		const AABB& aabb = aabbs_[endpoint.data >> 1];
+		endpoint.value = GetAxis((endpoint.data & 1) ? aabb.max : aabb.min, axis);
+	}
+}
+
+void SweepAndPrune::SortAxis(int axis, std::vector<CollisionPair>& added, std::vector<CollisionPair>& removed)
+{
+	std::vector<Endpoint>& endpoints = endpoints_[axis];
+	for (size_t i = 1; i < endpoints.size(); ++i)
+	{
+		const Endpoint key = endpoints[i];
+		const bool keyIsMax = (key.data & 1) != 0;
+		size_t j = i;
+		// 同じ座標なら最小側を先に置く（接している箱も重なりとみなすIsCollisionと合わせる）
+		while (j > 0 && (key.value < endpoints[j - 1].value || (key.value == endpoints[j - 1].value && !keyIsMax && (endpoints[j - 1].data & 1) != 0)))
+		{
+			const Endpoint& other = endpoints[j - 1];
+			const bool otherIsMax = (other.data & 1) != 0;
+			const uint32_t a = key.data >> 1;
+			const uint32_t b = other.data >> 1;
+			if (a != b && keyIsMax != otherIsMax)
+			{
+				if (!keyIsMax)
+				{
+					// 最小側が相手の最大側より前に来た：この軸で重なり始めた
+					if (mathFunc_.IsCollision(aabbs_[a], aabbs_[b]) && pairs_.insert(MakeKey(a, b)).second)
+					{
+						added.push_back(MakePair(MakeKey(a, b)));
+					}
+				}
+				else
+				{
+					// 最大側が相手の最小側より前に来た：この軸で離れた
+					if (pairs_.erase(MakeKey(a, b)) > 0)
+					{
+						removed.push_back(MakePair(MakeKey(a, b)));
+					}
+				}
+			}
+			endpoints[j] = other;
+			--j;
+			++swapCount_;
+		}
+		endpoints[j] = key;
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "AABB.h"
+#include "CollisionPair.h"
+#include "MathFunction.h"
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+/// <summary>
+/// Sweep and Prune（軸ごとに端点を並べて重なりを求める広域判定）。
+/// 端点の並びを前フレームから挿入ソートで更新し、重なりが変化した組だけを通知する。
+/// 球や線分はMathFunction::MakeAABBで囲んで登録し、詳細判定は呼び出し側で行う
+/// </summary>
+class SweepAndPrune
+{
+public:
+	/// <summary>
+	/// 端点を並べ直し、重なっている組を求める（物体の番号は配列の添え字）
+	/// </summary>
+	/// <param name="aabbs"></param>
+	/// <param name="count"></param>
+	void Build(const AABB* aabbs, uint32_t count);
+
+	/// <summary>
+	/// 物体のAABBを差し替える。Updateを呼ぶまで反映されない
+	/// </summary>
+	/// <param name="index"></param>
+	/// <param name="aabb"></param>
+	void SetAABB(uint32_t index, const AABB& aabb);
+	/// <summary>
+	/// 端点の並びを挿入ソートで更新し、重なり始めた組と離れた組を求める
+	/// </summary>
+	/// <param name="added">重なり始めた組（上書き・昇順）</param>
+	/// <param name="removed">離れた組（上書き・昇順）</param>
+	void Update(std::vector<CollisionPair>& added, std::vector<CollisionPair>& removed);
+
+	/// <summary>
+	/// 現在重なっている組
+	/// </summary>
+	/// <param name="pairs">結果（上書き・昇順）</param>
+	void GetPairs(std::vector<CollisionPair>& pairs) const;
+	/// <summary>
+	/// 現在重なっている組の数
+	/// </summary>
+	/// <returns></returns>
+	size_t GetPairCount() const { return pairs_.size(); }
+	/// <summary>
+	/// 前回のUpdateで端点を入れ替えた回数（フレーム間の変化量の目安）
+	/// </summary>
+	/// <returns></returns>
+	size_t GetSwapCount() const { return swapCount_; }
+	/// <summary>
+	/// 物体の数
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetCount() const { return uint32_t(aabbs_.size()); }
+
+private:
+	//軸上の端点
+	struct Endpoint final
+	{
+		float value;		//!<座標
+		uint32_t data;		//!<物体の番号 << 1 | 最大側なら1
+	};
+
+	/// <summary>
+	/// 端点の座標をAABBから取り直す
+	/// </summary>
+	/// <param name="axis"></param>
+	void RefreshValues(int axis);
+	/// <summary>
+	/// 1軸を挿入ソートし、入れ替わった端点から組の増減を求める
+	/// </summary>
+	/// <param name="axis"></param>
+	/// <param name="added"></param>
+	/// <param name="removed"></param>
+	void SortAxis(int axis, std::vector<CollisionPair>& added, std::vector<CollisionPair>& removed);
+
+	std::vector<AABB> aabbs_;						//物体のAABB
+	std::vector<Endpoint> endpoints_[3];			//軸ごとの端点（座標順、同じ座標なら最小側が先）
+	std::unordered_set<uint64_t> pairs_;			//重なっている組（first << 32 | second）
+	size_t swapCount_ = 0;							//前回のUpdateでの入れ替え回数
+	MathFunction mathFunc_;							//衝突判定
+};
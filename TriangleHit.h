@@ -0,0 +1,9 @@
+#pragma once
+
+//三角形との交点（交点 = origin + diff * t = vertices[0] * (1 - u - v) + vertices[1] * u + vertices[2] * v）
+struct TriangleHit final
+{
+	float t;	//!< 線の媒介変数（距離は t × diffの長さ）
+	float u;	//!< vertices[1]の重み
+	float v;	//!< vertices[2]の重み
+};
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+
+//SoA形式のベクトル配列（x,y,zを別々の配列で持つ）
+struct Vector3Span final
+{
+	float* x;		//!< x成分の配列
+	float* y;		//!< y成分の配列
+	float* z;		//!< z成分の配列
+	size_t count;	//!< 要素数
+};
+
+//SoA形式のベクトル配列（読み取り専用）
+struct ConstVector3Span final
+{
+	const float* x;		//!< x成分の配列
+	const float* y;		//!< y成分の配列
+	const float* z;		//!< z成分の配列
+	size_t count;		//!< 要素数
+};